@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Lab-frame electrostatic solve with the FFT Poisson solver (see inputs_2d):
+# the fields are compared with those of the MLMG solver, obtained by running
+# the same executable again with warpx.poisson_solver = multigrid.
+# - With periodic boundaries, both solvers solve the same finite-difference
+#   Poisson equation: the fields must agree to the precision of MLMG.
+# - With open boundaries, MLMG has no free-space boundary condition: it is run
+#   with grounded (pec) boundaries, on a domain that is 4 times larger with the
+#   same cell size, and the fields are compared in the domain of the FFT run.
+#   The charge distribution has no monopole moment, so the fields of the images
+#   decrease quickly with the size of the domain; the integrated Green's function
+#   of the FFT solver also differs from the finite-difference operator of MLMG
+#   by the discretization error.
+
+import glob
+import os
+import re
+import subprocess
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+filename = sys.argv[1]
+
+with open('warpx_used_inputs') as f:
+    used_inputs = f.read()
+periodic = re.search(r'^boundary\.field_lo\s*=\s*periodic\s+periodic\s*$', used_inputs, re.M) is not None
+
+n_cell = 64
+scale = 1 if periodic else 4
+executables = glob.glob('*.ex')
+assert len(executables) == 1
+command = [os.path.abspath(executables[0]), os.path.abspath('inputs_2d'),
+           'warpx.poisson_solver=multigrid',
+           'diag1.file_prefix=mlmg_plt', 'diag1.file_min_digits=5']
+if periodic:
+    command += ['boundary.field_lo=periodic periodic', 'boundary.field_hi=periodic periodic',
+                'boundary.particle_lo=periodic periodic', 'boundary.particle_hi=periodic periodic']
+else:
+    command += ['amr.n_cell={0} {0}'.format(scale*n_cell),
+                'geometry.prob_lo={0} {0}'.format(-20.e-6*scale),
+                'geometry.prob_hi={0} {0}'.format(20.e-6*scale)]
+print(' '.join(command))
+subprocess.run(command, check=True)
+
+def read_fields(plotfile, n):
+    ds = yt.load(plotfile)
+    ad = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=[n, n, 1])
+    return {field: ad[('mesh', field)].v.squeeze() for field in ['Ex', 'Ez', 'rho']}
+
+fft = read_fields(filename, n_cell)
+mlmg = read_fields('mlmg_plt' + filename.rstrip('/')[-5:], scale*n_cell)
+
+# Cells of the MLMG run that cover the domain of the FFT run
+offset = (scale - 1)*n_cell//2
+window = slice(offset, offset + n_cell)
+mlmg = {field: data[window, window] for field, data in mlmg.items()}
+
+# Same charge density
+assert np.allclose(fft['rho'], mlmg['rho'], rtol=1.e-9, atol=1.e-9*np.abs(fft['rho']).max())
+
+tolerance = 1.e-6 if periodic else 3.e-2
+for field in ['Ex', 'Ez']:
+    error = np.abs(fft[field] - mlmg[field]).max() / np.abs(mlmg[field]).max()
+    print('{} ({} boundaries): relative error {:e} (tolerance {:e})'.format(
+        field, 'periodic' if periodic else 'open', error, tolerance))
+    assert error < tolerance
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script checks the openPMD output of the FieldProbe diagnostic, with the
+input file inputs_2d_openpmd. The same static line probe is written as text
+rows (FP_text) and with openPMD (FP_opmd), with different numbers of
+accumulated steps: at each output step, both must contain all the probe points,
+with the same positions and fields.
+"""
+import glob
+
+import numpy as np
+import openpmd_api as io
+import pandas as pd
+
+npoints = 101
+output_steps = list(range(5, 41, 5))
+columns = ['x', 'y', 'z', 'Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz', 'S']
+
+# Text output: one row per probe point and output step
+df = pd.read_csv('diags/reducedfiles/FP_text.txt', sep=' ')
+df.columns = ['step', 'time'] + columns
+
+# openPMD output: one iteration per output step (bp with ADIOS, h5 otherwise)
+opmd_file = glob.glob('diags/reducedfiles/FP_opmd.*')[0]
+series = io.Series(opmd_file, io.Access.read_only)
+assert sorted(series.iterations) == output_steps, 'wrong openPMD iterations'
+assert sorted(df['step'].unique()) == output_steps, 'wrong text output steps'
+
+for step in output_steps:
+    text = df[df['step'] == step].sort_values(by='x')
+    assert len(text) == npoints, 'step {}: {} text rows'.format(step, len(text))
+
+    probe = series.iterations[step].particles['probe']
+    chunks = {}
+    for record, comp, name in [('position', 'x', 'x'), ('position', 'y', 'y'), ('position', 'z', 'z'),
+                               ('E', 'x', 'Ex'), ('E', 'y', 'Ey'), ('E', 'z', 'Ez'),
+                               ('B', 'x', 'Bx'), ('B', 'y', 'By'), ('B', 'z', 'Bz'),
+                               ('S', io.Record_Component.SCALAR, 'S')]:
+        chunks[name] = probe[record][comp].load_chunk()
+    series.flush()
+    order = np.argsort(chunks['x'])
+    assert len(order) == npoints, 'step {}: {} openPMD points'.format(step, len(order))
+
+    for name in columns:
+        text_values = text[name].to_numpy()
+        opmd_values = chunks[name][order]
+        assert np.allclose(text_values, opmd_values, rtol=1.e-12, atol=1.e-30), \
+            'step {}: {} differs between the text and openPMD outputs'.format(step, name)
+
+print('Passed')
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+
+# Back-transformed openPMD output with and without streaming of the particles
+# (see inputs_2d): the diagnostics btd_stream (stream_particles = 1) and
+# btd_redist (stream_particles = 0) write the same lab-frame snapshots. The
+# particles are written in a different order, but for each snapshot and each
+# species, the particles sorted by id must be the same.
+
+import numpy as np
+import openpmd_api as io
+
+species = ['electrons', 'ions']
+records = [('position', ['x', 'z']), ('momentum', ['x', 'y', 'z']),
+           ('weighting', [io.Record_Component.SCALAR])]
+
+def read_particles(diag_name):
+    series = io.Series('diags/{}/openpmd_%T.bp'.format(diag_name), io.Access.read_only)
+    data = {}
+    for iteration in series.iterations:
+        it = series.iterations[iteration]
+        for sp in species:
+            p = it.particles[sp]
+            chunks = {'id': p['id'][io.Record_Component.SCALAR].load_chunk()}
+            for record, comps in records:
+                for comp in comps:
+                    chunks['{}_{}'.format(record, comp)] = p[record][comp].load_chunk()
+            series.flush()
+            data[(iteration, sp)] = chunks
+    del series
+    return data
+
+stream = read_particles('btd_stream')
+redist = read_particles('btd_redist')
+assert sorted(stream) == sorted(redist), 'The snapshots differ'
+
+total = 0
+for key in sorted(stream):
+    s, r = stream[key], redist[key]
+    print('snapshot {}, {}: {} particles'.format(key[0], key[1], len(s['id'])))
+    assert len(s['id']) == len(r['id']), '{}: different numbers of particles'.format(key)
+    assert len(np.unique(s['id'])) == len(s['id']), '{}: duplicate ids'.format(key)
+    s_order = np.argsort(s['id'])
+    r_order = np.argsort(r['id'])
+    for name in s:
+        assert np.array_equal(s[name][s_order], r[name][r_order]), \
+            '{}: {} differs with stream_particles = 0 and 1'.format(key, name)
+    total += len(s['id'])
+
+assert total > 0, 'No particles in the back-transformed snapshots'
+print('Passed')
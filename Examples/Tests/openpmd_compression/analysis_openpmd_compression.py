@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+
+# Compression of the openPMD output (see inputs_2d): the same data is written
+# by the diagnostics "raw", without compression, and "comp", with
+# - an ADIOS2 ZFP operator on the fields, with an error bound relative to the
+#   range of each component: the difference with the raw fields must be within
+#   this bound;
+# - an ADIOS2 Blosc operator on the particle attributes: lossless, so the
+#   particles must be identical.
+# The achieved compression ratio is the ratio of the sizes of the .bp files.
+
+import os
+
+import numpy as np
+import openpmd_api as io
+
+iteration = 40
+relative_error_bound = 1.e-4
+fields = {'E': ['x', 'y', 'z'], 'B': ['x', 'y', 'z'], 'j': ['x', 'y', 'z'], 'rho': [None]}
+species = ['electrons', 'positrons']
+
+def read_fields_and_particles(diag_name):
+    series = io.Series('diags/{}/openpmd_%T.bp'.format(diag_name), io.Access.read_only)
+    it = series.iterations[iteration]
+    data = {}
+    for name, comps in fields.items():
+        for comp in comps:
+            rc = it.meshes[name][comp if comp else io.Mesh_Record_Component.SCALAR]
+            data[name + (comp or '')] = rc.load_chunk()
+    for sp in species:
+        p = it.particles[sp]
+        for record, comps in [('position', ['x', 'z']), ('momentum', ['x', 'y', 'z']),
+                              ('weighting', [io.Record_Component.SCALAR]), ('id', [io.Record_Component.SCALAR])]:
+            for comp in comps:
+                data['{}_{}_{}'.format(sp, record, comp)] = p[record][comp].load_chunk()
+    series.flush()
+    del series
+    return data
+
+def du(path):
+    size = 0
+    for root, _, files in os.walk(path):
+        size += sum(os.path.getsize(os.path.join(root, f)) for f in files)
+    return size
+
+raw = read_fields_and_particles('raw')
+comp = read_fields_and_particles('comp')
+
+for name, comps in fields.items():
+    for c in comps:
+        key = name + (c or '')
+        error_bound = relative_error_bound * (raw[key].max() - raw[key].min())
+        error = np.abs(comp[key] - raw[key]).max()
+        print('{}: max error {:e} (error bound {:e})'.format(key, error, error_bound))
+        assert error <= error_bound
+
+for key in raw:
+    if key.split('_')[0] in species:
+        assert np.array_equal(raw[key], comp[key]), key + ' differs with lossless compression'
+
+raw_bytes = du('diags/raw/openpmd_{:06d}.bp'.format(iteration))
+comp_bytes = du('diags/comp/openpmd_{:06d}.bp'.format(iteration))
+print('compression ratio: {} -> {} bytes ({:.2f})'.format(raw_bytes, comp_bytes, raw_bytes/comp_bytes))
+assert comp_bytes < raw_bytes
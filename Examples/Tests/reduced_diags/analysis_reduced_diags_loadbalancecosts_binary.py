@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+
+# This script tests the binary output format of the reduced diagnostics
+# `LoadBalanceCosts` (LBC.output_format = binary). The rows of LBC.bin are
+# read back with the column indices of the header in LBC.txt, and the same
+# checks as in analysis_reduced_diags_loadbalancecosts.py are done: the
+# efficiency improves after the load balance step.
+
+import re
+import sys
+
+import numpy as np
+
+# Header: "#[0]step() [1]time(s) [2]cost_box_0() ..."
+with open("./diags/reducedfiles/LBC.txt") as f:
+    lines = f.readlines()
+assert len(lines) == 1, 'The text file must only contain the header'
+columns = {name: int(index) for index, name in re.findall(r'\[(\d+)\](\w+)\(', lines[0])}
+assert not any(name.startswith('hostname') for name in columns), \
+    'The hostnames are not written in binary format'
+
+# Rows: number of values (int64), then the values (float64)
+rows = []
+with open("./diags/reducedfiles/LBC.bin", 'rb') as f:
+    while True:
+        n = np.fromfile(f, dtype=np.int64, count=1)
+        if n.size == 0:
+            break
+        rows.append(np.fromfile(f, dtype=np.float64, count=int(n[0])))
+assert len(rows) > 2
+
+n_boxes = len([name for name in columns if name.startswith('cost_box_')])
+n_data_fields = (len(columns) - 2) // n_boxes
+for i, row in enumerate(rows):
+    assert row[columns['step']] == i+1
+    assert (len(row) - 2) % n_data_fields == 0
+    for b in range((len(row) - 2) // n_data_fields):
+        # the values are in the columns given by the header
+        assert row[columns['lev_box_{}'.format(b)]] == 0
+        assert row[columns['num_cells_{}'.format(b)]] > 0
+        assert row[columns['proc_box_{}'.format(b)]] in (0, 1)
+
+def get_efficiency(row):
+    nb = (len(row) - 2) // n_data_fields
+    costs = np.array([row[columns['cost_box_{}'.format(b)]] for b in range(nb)])
+    ranks = np.array([row[columns['proc_box_{}'.format(b)]] for b in range(nb)]).astype(int)
+    rank_to_cost = np.zeros(ranks.max()+1)
+    np.add.at(rank_to_cost, ranks, costs)
+    rank_to_cost = rank_to_cost[np.unique(ranks)]
+    return (rank_to_cost/rank_to_cost.max()).mean()
+
+# The iteration i=2 is load balanced; examine before/after load balance
+efficiency_before, efficiency_after = get_efficiency(rows[1]), get_efficiency(rows[2])
+print('load balance efficiency (before load balance): ', efficiency_before)
+print('load balance efficiency (after load balance): ', efficiency_after)
+assert(efficiency_before < efficiency_after)
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+# This script tests the PML cells in the `Heuristic` costs of the reduced
+# diagnostics `LoadBalanceCosts` (see inputs_loadbalancecosts_pml): the grid
+# boxes of the domain all have the same number of cells, and the boxes at the
+# edges of the domain are attached to PML boxes.
+# - With algo.costs_heuristic_pml_cells_wt = 0, the PML cells are not counted:
+#   all the boxes have the same cost.
+# - Otherwise (by default, twice algo.costs_heuristic_cells_wt), the boxes at
+#   the edges of the domain cost more than the boxes inside the domain.
+
+import re
+
+import numpy as np
+
+warpx_used_inputs = open('./warpx_used_inputs', 'r').read()
+count_pml_cells = not re.search(r'algo.costs_heuristic_pml_cells_wt\s*=\s*0\s*$',
+                                warpx_used_inputs, re.MULTILINE)
+
+n_cell = 64
+max_grid_size = 16
+
+# Header: "#[0]step() [1]time(s) [2]cost_box_0() ..."
+with open('./diags/reducedfiles/LBC.txt') as f:
+    lines = f.readlines()
+columns = {name: int(index) for index, name in re.findall(r'\[(\d+)\](\w+)\(', lines[0])}
+n_boxes = len([name for name in columns if name.startswith('cost_box_')])
+assert n_boxes == (n_cell // max_grid_size)**2
+
+for line in lines[1:]:
+    row = line.split()
+    edge_costs = []
+    inner_costs = []
+    for b in range(n_boxes):
+        cost = float(row[columns['cost_box_{}'.format(b)]])
+        i_low = int(float(row[columns['i_low_box_{}'.format(b)]]))
+        j_low = int(float(row[columns['j_low_box_{}'.format(b)]]))
+        at_edge = (min(i_low, j_low) == 0) or (max(i_low, j_low) == n_cell - max_grid_size)
+        (edge_costs if at_edge else inner_costs).append(cost)
+    edge_costs = np.array(edge_costs)
+    inner_costs = np.array(inner_costs)
+    print('step {}: costs of the boxes inside the domain {}, at the edges {}'.format(
+        row[columns['step']], inner_costs, edge_costs))
+
+    assert np.all(inner_costs == inner_costs[0])
+    if count_pml_cells:
+        assert np.all(edge_costs > inner_costs[0])
+    else:
+        assert np.all(edge_costs == inner_costs[0])
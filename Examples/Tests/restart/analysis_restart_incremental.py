@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+# Restart from an incremental checkpoint (see inputs_incremental_2d):
+# - the restart checkpoint must be incremental, and must not contain the
+#   immobile species, which is read from the base checkpoint;
+# - the data after the restart must be the same as in the uninterrupted run;
+# - the incremental checkpoint can be restarted after the checkpoints are moved,
+#   from another working directory, through an absolute path.
+
+import glob
+import os
+import shutil
+import subprocess
+import sys
+
+filename = sys.argv[1]
+test_name = os.path.split(os.getcwd())[1]
+
+# Incremental checkpoint used for the restart (restartFileNum)
+checkpoint = test_name + '_chk00006'
+manifest = os.path.join(checkpoint, 'WarpXIncremental')
+assert os.path.isfile(manifest), 'The restart checkpoint is not incremental'
+
+with open(manifest) as f:
+    lines = f.read().split()
+base_name = lines[0]
+skipped = lines[2:2+int(lines[1])]
+print('Checkpoint {} reads from {}: {}'.format(checkpoint, base_name, ' '.join(skipped)))
+assert base_name == '../' + test_name + '_chk00004'
+assert 'particles/ions' in skipped
+assert 'particles/electrons' not in skipped
+assert not os.path.isdir(os.path.join(checkpoint, 'ions'))
+
+# Check restart data v. original data
+sys.path.insert(0, '../../../../warpx/Examples/')
+from analysis_default_restart import check_restart
+
+check_restart(filename)
+
+# Move the base and incremental checkpoints, and restart from another directory
+moved_dir = os.path.abspath('moved_checkpoints')
+run_dir = os.path.abspath('other_run_dir')
+os.makedirs(moved_dir, exist_ok=True)
+os.makedirs(run_dir, exist_ok=True)
+for chk in [test_name + '_chk00004', checkpoint]:
+    shutil.copytree(chk, os.path.join(moved_dir, chk))
+executables = glob.glob('*.ex')
+assert len(executables) == 1
+command = [os.path.abspath(executables[0]), os.path.abspath('inputs_incremental_2d'),
+           'amr.restart=' + os.path.join(moved_dir, checkpoint),
+           'diagnostics.diags_names=diag1',
+           'diag1.file_prefix=' + os.path.abspath('moved_plt'), 'diag1.file_min_digits=5']
+print(' '.join(command))
+subprocess.run(command, check=True, cwd=run_dir)
+
+moved_plotfile = 'moved_plt00012'
+os.symlink('orig_' + filename.rstrip('/'), 'orig_' + moved_plotfile)
+check_restart(moved_plotfile)
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+
+# Restart on a different number of MPI ranks (see inputs_nprocs_2d):
+# - the first run uses 2 MPI ranks, and the restart 3 MPI ranks, so that the
+#   boxes are distributed according to the number of particles of each box
+#   stored in the checkpoint (algo.load_balance_on_restart);
+# - the particles of the immobile species "beam" are only read from the
+#   checkpoint when the diagnostics first output them (beam.restart_deferred = 1);
+# - the data after the restart must be the same as in the uninterrupted run.
+#
+# This script launches the MPI runs itself: the test is not run with MPI
+# by the regression harness (useMPI = 0), but the executable is built with MPI.
+
+import glob
+import os
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, '../../../../warpx/Examples/')
+from analysis_default_restart import check_restart
+
+inputs = 'inputs_nprocs_2d'
+plotfile = 'plt00020'
+checkpoint = 'chk00010'
+
+def run(executable, nprocs, *args):
+    command = ['mpiexec', '-n', str(nprocs), './' + executable, inputs] + list(args)
+    print(' '.join(command))
+    output = subprocess.run(command, check=True, stdout=subprocess.PIPE,
+                            universal_newlines=True).stdout
+    print(output)
+    return output
+
+def main():
+    executables = glob.glob('*.ex')
+    assert len(executables) == 1
+
+    # Uninterrupted run, on 2 MPI ranks
+    run(executables[0], 2)
+    assert os.path.isfile(os.path.join(checkpoint, 'Level_0', 'NumParticles'))
+    shutil.move(plotfile, 'orig_' + plotfile)
+
+    # Restart on 3 MPI ranks
+    output = run(executables[0], 3, 'amr.restart=' + checkpoint)
+    assert 'MPI ranks according to their costs in the checkpoint' in output
+    assert 'Reading the particles of species beam' in output
+
+    # the guard cell sums are done in a different order on 3 MPI ranks
+    check_restart(plotfile, tolerance = 1e-10)
+    print('Passed')
+
+if __name__ == '__main__':
+    main()
@@ -40,6 +40,7 @@
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_RealVect.H>
 #include <AMReX_SPACE.H>
@@ -50,6 +51,7 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 #ifdef AMREX_USE_EB
 #   include "AMReX_EBFabFactory.H"
 #endif
@@ -640,8 +642,12 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         ngf = ngFFT;
     }
 
+    m_grid_owners_fp = FindGridOwners(ba, grid_ba);
+
     DistributionMapping dm;
-    if (WarpX::do_similar_dm_pml) {
+    if (WarpX::do_pml_load_balance) {
+        dm = MakeOwnerDM(m_grid_owners_fp, grid_dm);
+    } else if (WarpX::do_similar_dm_pml) {
         auto ng_sim = amrex::elemwiseMax(amrex::elemwiseMax(nge, ngb), ngf);
         dm = amrex::MakeSimilarDM(ba, grid_ba, grid_dm, ng_sim);
     } else {
@@ -733,6 +739,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
 
     Box single_domain_box = is_single_box_domain ? domain0 : Box();
     // Empty box (i.e., Box()) means it's not a single box domain.
+    m_sigba_args_fp = {grid_ba_reduced, IntVect(ncell), IntVect(delta), single_domain_box, v_sigma_sb};
     sigba_fp = std::make_unique<MultiSigmaBox>(ba, dm, grid_ba_reduced, geom->CellSize(),
                                                IntVect(ncell), IntVect(delta), single_domain_box, v_sigma_sb);
 
@@ -798,8 +805,12 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         // Assuming that refinement ratio is equal in all dimensions
         const BoxArray& cba = MakeBoxArray(is_single_box_domain, cdomain, *cgeom, grid_cba_reduced,
                                            cncells, do_pml_in_domain, do_pml_Lo, do_pml_Hi);
+        m_grid_owners_cp = FindGridOwners(cba, grid_cba);
+
         DistributionMapping cdm;
-        if (WarpX::do_similar_dm_pml) {
+        if (WarpX::do_pml_load_balance) {
+            cdm = MakeOwnerDM(m_grid_owners_cp, grid_dm);
+        } else if (WarpX::do_similar_dm_pml) {
             auto ng_sim = amrex::elemwiseMax(amrex::elemwiseMax(nge, ngb), ngf);
             cdm = amrex::MakeSimilarDM(cba, grid_cba_reduced, grid_dm, ng_sim);
         } else {
@@ -855,6 +866,7 @@ PML::PML (const int lev, const BoxArray& grid_ba, const DistributionMapping& gri
         pml_j_cp[2]->setVal(0.0);
 
         single_domain_box = is_single_box_domain ? cdomain : Box();
+        m_sigba_args_cp = {grid_cba_reduced, cncells, cdelta, single_domain_box, v_sigma_sb};
         sigba_cp = std::make_unique<MultiSigmaBox>(cba, cdm, grid_cba_reduced, cgeom->CellSize(),
                                                    cncells, cdelta, single_domain_box, v_sigma_sb);
 
@@ -1012,6 +1024,153 @@ PML::MakeBoxArray_multiple (const amrex::Geometry& geom, const amrex::BoxArray&
     return ba;
 }
 
+amrex::Vector<int>
+PML::FindGridOwners (const amrex::BoxArray& pml_ba, const amrex::BoxArray& grid_ba)
+{
+    amrex::Vector<int> owners(pml_ba.size(), -1);
+    std::vector<std::pair<int,Box>> isects;
+    for (int i = 0, N = pml_ba.size(); i < N; ++i)
+    {
+        // PML boxes are either adjacent to the grids, or overlap with them (do_pml_in_domain):
+        // growing them by one cell also finds the grid boxes that only touch their corners
+        grid_ba.intersections(amrex::grow(pml_ba[i], 1), isects);
+        amrex::Long max_pts = 0;
+        for (auto const& is : isects)
+        {
+            if (is.second.numPts() > max_pts)
+            {
+                max_pts = is.second.numPts();
+                owners[i] = is.first;
+            }
+        }
+    }
+    return owners;
+}
+
+amrex::DistributionMapping
+PML::MakeOwnerDM (const amrex::Vector<int>& grid_owners, const amrex::DistributionMapping& grid_dm)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+    amrex::Vector<int> pmap(grid_owners.size());
+    for (int i = 0, N = grid_owners.size(); i < N; ++i)
+    {
+        pmap[i] = (grid_owners[i] >= 0) ? grid_dm[grid_owners[i]] : i % nprocs;
+    }
+    return amrex::DistributionMapping(std::move(pmap));
+}
+
+void
+PML::DistributeCosts (amrex::LayoutData<amrex::Real>& cost, PatchType patch_type,
+                      amrex::Real wt, bool per_cell) const
+{
+    if (!m_ok) return;
+    const MultiSigmaBox* sigba = (patch_type == PatchType::fine) ? sigba_fp.get() : sigba_cp.get();
+    if (sigba == nullptr) return;
+    const amrex::Vector<int>& owners = (patch_type == PatchType::fine) ? m_grid_owners_fp
+                                                                       : m_grid_owners_cp;
+    const amrex::BoxArray& ba = sigba->boxArray();
+    const amrex::DistributionMapping& cost_dm = cost.DistributionMap();
+    const int myproc = ParallelDescriptor::MyProc();
+
+    amrex::Real cell_wt = wt;
+    if (!per_cell)
+    {
+        amrex::Long ncells = 0;
+        for (int i : sigba->IndexArray()) ncells += ba[i].numPts();
+        if (ncells == 0) return;
+        cell_wt = wt / static_cast<amrex::Real>(ncells);
+    }
+
+    for (int i : sigba->IndexArray())
+    {
+        const int owner = owners[i];
+        // costs are local: only the grid boxes of this rank can be updated
+        if (owner >= 0 && cost_dm[owner] == myproc)
+        {
+            cost[owner] += cell_wt * static_cast<amrex::Real>(ba[i].numPts());
+        }
+    }
+}
+
+void
+PML::AddCosts (amrex::LayoutData<amrex::Real>& cost, PatchType patch_type, amrex::Real wt) const
+{
+    DistributeCosts(cost, patch_type, wt, false);
+}
+
+void
+PML::AddCellCosts (amrex::LayoutData<amrex::Real>& cost, PatchType patch_type,
+                   amrex::Real cell_wt) const
+{
+    DistributeCosts(cost, patch_type, cell_wt, true);
+}
+
+void
+PML::Redistribute (const amrex::DistributionMapping& grid_dm, amrex::Real dt)
+{
+    if (!m_ok) return;
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::maxwell_solver_id != MaxwellSolverAlgo::PSATD,
+        "The PML boxes can only be redistributed with the FDTD solvers");
+
+    auto remake = [] (std::unique_ptr<MultiFab>& mf, const DistributionMapping& dm)
+    {
+        if (mf == nullptr) return;
+        const IntVect& ng = mf->nGrowVect();
+        auto pmf = std::make_unique<MultiFab>(mf->boxArray(), dm, mf->nComp(), ng);
+        pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng);
+        mf = std::move(pmf);
+    };
+
+    // Fine patch
+    const DistributionMapping dm = MakeOwnerDM(m_grid_owners_fp, grid_dm);
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        remake(pml_E_fp[idim], dm);
+        remake(pml_B_fp[idim], dm);
+        remake(pml_j_fp[idim], dm);
+        remake(pml_edge_lengths[idim], dm);
+    }
+    remake(pml_F_fp, dm);
+    remake(pml_G_fp, dm);
+
+    const BoxArray ba = sigba_fp->boxArray();
+    sigba_fp = std::make_unique<MultiSigmaBox>(ba, dm, m_sigba_args_fp.grid_ba, m_geom->CellSize(),
+                                               m_sigba_args_fp.ncell, m_sigba_args_fp.delta,
+                                               m_sigba_args_fp.regular_domain,
+                                               m_sigba_args_fp.v_sigma_sb);
+
+#ifdef AMREX_USE_EB
+    const int max_guard_EB = pml_edge_lengths[0]->nGrow();
+    pml_field_factory = amrex::makeEBFabFactory(*m_geom, ba, dm,
+                                                {max_guard_EB, max_guard_EB, max_guard_EB},
+                                                amrex::EBSupport::full);
+#endif
+
+    // Coarse patch
+    if (sigba_cp)
+    {
+        const DistributionMapping cdm = MakeOwnerDM(m_grid_owners_cp, grid_dm);
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            remake(pml_E_cp[idim], cdm);
+            remake(pml_B_cp[idim], cdm);
+            remake(pml_j_cp[idim], cdm);
+        }
+        remake(pml_F_cp, cdm);
+        remake(pml_G_cp, cdm);
+
+        const BoxArray cba = sigba_cp->boxArray();
+        sigba_cp = std::make_unique<MultiSigmaBox>(cba, cdm, m_sigba_args_cp.grid_ba,
+                                                   m_cgeom->CellSize(),
+                                                   m_sigba_args_cp.ncell, m_sigba_args_cp.delta,
+                                                   m_sigba_args_cp.regular_domain,
+                                                   m_sigba_args_cp.v_sigma_sb);
+    }
+
+    ComputePMLFactors(dt);
+}
+
 void
 PML::ComputePMLFactors (amrex::Real dt)
 {
@@ -1405,11 +1564,12 @@ PML::Restart (const std::string& dir)
 
 #ifdef WARPX_USE_PSATD
 void
-PML::PushPSATD (const int lev) {
+PML::PushPSATD (const int lev, PatchType patch_type) {
 
-    // Update the fields on the fine and coarse patch
-    PushPMLPSATDSinglePatch(lev, *spectral_solver_fp, pml_E_fp, pml_B_fp, pml_F_fp, pml_G_fp, m_fill_guards_fields);
-    if (spectral_solver_cp) {
+    // Update the fields on the fine or coarse patch
+    if (patch_type == PatchType::fine) {
+        PushPMLPSATDSinglePatch(lev, *spectral_solver_fp, pml_E_fp, pml_B_fp, pml_F_fp, pml_G_fp, m_fill_guards_fields);
+    } else if (spectral_solver_cp) {
         PushPMLPSATDSinglePatch(lev, *spectral_solver_cp, pml_E_cp, pml_B_cp, pml_F_cp, pml_G_cp, m_fill_guards_fields);
     }
 }
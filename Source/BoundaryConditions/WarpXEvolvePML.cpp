@@ -80,6 +80,8 @@ WarpX::DampPML_Cartesian (const int lev, PatchType patch_type)
 
     if (pml[lev]->ok())
     {
+        const amrex::Real wt = PMLCostsTimerStart(lev);
+
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
         const auto& pml_B = (patch_type == PatchType::fine) ? pml[lev]->GetB_fp() : pml[lev]->GetB_cp();
         const auto& pml_F = (patch_type == PatchType::fine) ? pml[lev]->GetF_fp() : pml[lev]->GetF_cp();
@@ -149,45 +151,48 @@ WarpX::DampPML_Cartesian (const int lev, PatchType patch_type)
             int const z_lo = sigba[mfi].sigma_fac[1].lo();
 #endif
 
-            amrex::ParallelFor(tex, tey, tez,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_ex(i, j, k, pml_Exfab, Ex_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  dive_cleaning);
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_ey(i, j, k, pml_Eyfab, Ey_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  dive_cleaning);
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_ez(i, j, k, pml_Ezfab, Ez_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  dive_cleaning);
-            });
-
-            amrex::ParallelFor(tbx, tby, tbz,
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_bx(i, j, k, pml_Bxfab, Bx_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  divb_cleaning);
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_by(i, j, k, pml_Byfab, By_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  divb_cleaning);
-            },
-            [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-
-                warpx_damp_pml_bz(i, j, k, pml_Bzfab, Bz_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
-                                  sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
-                                  divb_cleaning);
-            });
+            // With fused damping, E and B are damped by EvolveEPML and EvolveBPML
+            if (!pml_fused_damping) {
+                amrex::ParallelFor(tex, tey, tez,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_ex(i, j, k, pml_Exfab, Ex_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      dive_cleaning);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_ey(i, j, k, pml_Eyfab, Ey_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      dive_cleaning);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_ez(i, j, k, pml_Ezfab, Ez_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      dive_cleaning);
+                });
+
+                amrex::ParallelFor(tbx, tby, tbz,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_bx(i, j, k, pml_Bxfab, Bx_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      divb_cleaning);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_by(i, j, k, pml_Byfab, By_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      divb_cleaning);
+                },
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+
+                    warpx_damp_pml_bz(i, j, k, pml_Bzfab, Bz_stag, sigma_fac_x, sigma_fac_y, sigma_fac_z,
+                                      sigma_star_fac_x, sigma_star_fac_y, sigma_star_fac_z, x_lo, y_lo, z_lo,
+                                      divb_cleaning);
+                });
+            }
 
             // For warpx_damp_pml_F(), mfi.nodaltilebox is used in the ParallelFor loop and here we
             // use mfi.tilebox. However, it does not matter because in damp_pml, where nodaltilebox
@@ -213,6 +218,8 @@ WarpX::DampPML_Cartesian (const int lev, PatchType patch_type)
                 });
             }
         }
+
+        PMLCostsTimerStop(lev, patch_type, wt);
     }
 }
 
@@ -33,12 +33,14 @@
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_ParticleTransformation.H>
 #include <AMReX_Utility.H>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <memory>
+#include <utility>
 #include <vector>
 
 using namespace amrex::literals;
@@ -175,6 +177,8 @@ BTDiagnostics::ReadParameters ()
     if (queryWithParser(pp_diag_name, "buffer_size", m_buffer_size)) {
         if(m_max_box_size < m_buffer_size) m_max_box_size = m_buffer_size;
     }
+    pp_diag_name.query("reuse_slice_plans", m_reuse_slice_plans);
+    pp_diag_name.query("batch_back_transform", m_batch_back_transform);
 
     amrex::Vector< std::string > BTD_varnames_supported = {"Ex", "Ey", "Ez",
                                                            "Bx", "By", "Bz",
@@ -435,7 +439,7 @@ BTDiagnostics::InitializeFieldFunctors (int lev)
         int nvars = static_cast<int>(m_varnames.size());
         m_all_field_functors[lev][i] = std::make_unique<BackTransformFunctor>(
                   m_cell_centered_data[lev].get(), lev,
-                  nvars, m_num_buffers, m_varnames);
+                  nvars, m_num_buffers, m_varnames, m_reuse_slice_plans);
     }
 
     // Define all cell-centered functors required to compute cell-centere data
@@ -578,6 +582,17 @@ BTDiagnostics::PrepareFieldDataForOutput ()
 
             }
         }
+        // Back-transform the slices of all the snapshots at once. The calls to the
+        // functors in ComputeAndPack then skip the buffers that were transformed here.
+        if (m_batch_back_transform) {
+            amrex::Vector<amrex::MultiFab*> mf_dst(m_num_buffers);
+            for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+                mf_dst[i_buffer] = &m_mf_output[i_buffer][lev];
+            }
+            auto const& bt_functor =
+                static_cast<BackTransformFunctor const&>(*m_all_field_functors[lev][0]);
+            bt_functor.BackTransformBuffers(mf_dst);
+        }
     }
 }
 
@@ -737,6 +752,8 @@ BTDiagnostics::Flush (int i_buffer)
     bool const use_pinned_pc = true;
     bool const isBTD = true;
     double const labtime = m_t_lab[i_buffer];
+    // The plotfile output needs the particles to be sorted in the boxes of the buffer
+    bool const stream_particles = m_stream_particles && m_format == "openpmd";
 
     amrex::Vector<amrex::BoxArray> vba;
     amrex::Vector<amrex::DistributionMapping> vdmap;
@@ -753,28 +770,34 @@ BTDiagnostics::Flush (int i_buffer)
                 vrefratio.push_back(m_particles_buffer[i_buffer][0]->GetParGDB()->refRatio(lev));
             }
         }
-        // Redistribute particles in the lab frame box arrays that correspond to the buffer
-        // Prior to redistribute, increase buffer box and Box in ParticleBoxArray by 1 index in the
-        // lo and hi-end, so particles can be binned in the boxes correctly.
-        // For BTD, we may have particles that are out of the domain by half a cell-size or one cell size.
-        // As a result, the index they correspond to may be out of the box by one index
-        // As a work around to the locateParticle error in Redistribute, we increase the box size before
-        // redistribute and shrink it after the call to redistribute.
-        m_buffer_box[i_buffer].setSmall(m_moving_window_dir, (m_buffer_box[i_buffer].smallEnd(m_moving_window_dir) - 1) );
-        m_buffer_box[i_buffer].setBig(m_moving_window_dir, (m_buffer_box[i_buffer].bigEnd(m_moving_window_dir) + 1) );
-        amrex::Box particle_buffer_box = m_buffer_box[i_buffer];
-        amrex::BoxArray buffer_ba( particle_buffer_box );
-        buffer_ba.maxSize(m_max_box_size*2);
-        m_particles_buffer[i_buffer][0]->SetParticleBoxArray(0, buffer_ba);
-        for (int isp = 0; isp < m_particles_buffer.at(i_buffer).size(); ++isp) {
-            // BTD output is single level. Setting particle geometry, dmap, boxarray to level0
-            m_particles_buffer[i_buffer][isp]->SetParGDB(vgeom[0], vdmap[0], buffer_ba);
+        if (stream_particles) {
+            // Each rank writes its own particles, at offsets obtained from a scan of the
+            // number of particles over the ranks: no redistribution is needed.
+            MergeParticleBufferOnRank(i_buffer, vgeom[0]);
+        } else {
+            // Redistribute particles in the lab frame box arrays that correspond to the buffer
+            // Prior to redistribute, increase buffer box and Box in ParticleBoxArray by 1 index in the
+            // lo and hi-end, so particles can be binned in the boxes correctly.
+            // For BTD, we may have particles that are out of the domain by half a cell-size or one cell size.
+            // As a result, the index they correspond to may be out of the box by one index
+            // As a work around to the locateParticle error in Redistribute, we increase the box size before
+            // redistribute and shrink it after the call to redistribute.
+            m_buffer_box[i_buffer].setSmall(m_moving_window_dir, (m_buffer_box[i_buffer].smallEnd(m_moving_window_dir) - 1) );
+            m_buffer_box[i_buffer].setBig(m_moving_window_dir, (m_buffer_box[i_buffer].bigEnd(m_moving_window_dir) + 1) );
+            amrex::Box particle_buffer_box = m_buffer_box[i_buffer];
+            amrex::BoxArray buffer_ba( particle_buffer_box );
+            buffer_ba.maxSize(m_max_box_size*2);
+            m_particles_buffer[i_buffer][0]->SetParticleBoxArray(0, buffer_ba);
+            for (int isp = 0; isp < m_particles_buffer.at(i_buffer).size(); ++isp) {
+                // BTD output is single level. Setting particle geometry, dmap, boxarray to level0
+                m_particles_buffer[i_buffer][isp]->SetParGDB(vgeom[0], vdmap[0], buffer_ba);
+            }
         }
     }
-    RedistributeParticleBuffer(i_buffer);
+    if (!stream_particles) RedistributeParticleBuffer(i_buffer);
 
     // Reset buffer box and particle box array
-    if (m_format == "openpmd") {
+    if (m_format == "openpmd" && !stream_particles) {
         if (m_particles_buffer.at(i_buffer).size() > 0 ) {
             m_buffer_box[i_buffer].setSmall(m_moving_window_dir, (m_buffer_box[i_buffer].smallEnd(m_moving_window_dir) + 1) );
             m_buffer_box[i_buffer].setBig(m_moving_window_dir, (m_buffer_box[i_buffer].bigEnd(m_moving_window_dir) - 1) );
@@ -817,6 +840,48 @@ void BTDiagnostics::RedistributeParticleBuffer (const int i_buffer)
     }
 }
 
+void BTDiagnostics::MergeParticleBufferOnRank (const int i_buffer, amrex::Geometry const& geom)
+{
+    // The particle buffer is defined on one box per rank (the buffer box), owned by
+    // that rank, so that all the particles of a rank are in the same tile, at level 0.
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+    const int myproc = amrex::ParallelDescriptor::MyProc();
+    amrex::BoxList bl;
+    amrex::Vector<int> pmap(nprocs);
+    for (int iproc = 0; iproc < nprocs; ++iproc) {
+        bl.push_back(m_buffer_box[i_buffer]);
+        pmap[iproc] = iproc;
+    }
+    const amrex::BoxArray rank_ba(std::move(bl));
+    const amrex::DistributionMapping rank_dmap(std::move(pmap));
+
+    using ParticleTileType = PinnedMemoryParticleContainer::ParticleTileType;
+    for (int isp = 0; isp < m_particles_buffer.at(i_buffer).size(); ++isp) {
+        auto& pc = *m_particles_buffer[i_buffer][isp];
+        // Take the non-empty tiles of this rank, from all the levels
+        amrex::Vector<ParticleTileType> tiles;
+        for (int lev = 0; lev < pc.numLevels(); ++lev) {
+            for (auto& kv : pc.GetParticles(lev)) {
+                if (kv.second.numParticles() > 0) tiles.push_back(std::move(kv.second));
+            }
+        }
+        pc.clearParticles();
+        // BTD output is single level. Setting particle geometry, dmap, boxarray to level0
+        pc.SetParGDB(geom, rank_dmap, rank_ba);
+        auto& ptile_dst = pc.DefineAndReturnParticleTile(0, myproc, 0);
+        if (tiles.size() == 1) {
+            ptile_dst = std::move(tiles[0]);
+        } else {
+            for (auto const& ptile_src : tiles) {
+                const auto np = ptile_src.numParticles();
+                const auto old_size = ptile_dst.numParticles();
+                ptile_dst.resize(old_size + np);
+                amrex::copyParticles(ptile_dst, ptile_src, 0, old_size, np);
+            }
+        }
+    }
+}
+
 void BTDiagnostics::MergeBuffersForPlotfile (int i_snapshot)
 {
     // Make sure all MPI ranks wrote their files and closed it
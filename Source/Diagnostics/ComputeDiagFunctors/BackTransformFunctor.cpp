@@ -25,17 +25,55 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_MultiFabUtil.H>
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <memory>
 
 using namespace amrex;
 
+namespace
+{
+    /** \brief Lab-frame value of one component of the boosted-frame data, linearly
+     *  interpolated between the cells iv and iv_p.
+     *
+     * \param[in] f boosted-frame data, with the components Ex Ey Ez Bx By Bz jx jy jz rho
+     * \param[in] iv cell of the lower point of the interpolation
+     * \param[in] iv_p cell of the upper point of the interpolation
+     * \param[in] w weight of the upper point
+     * \param[in] icomp component of f to transform
+     * \param[in] gamma_boost Lorentz factor of the boosted frame
+     * \param[in] beta_boost velocity of the boosted frame, normalized by c
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    amrex::Real LabFrameComponent (amrex::Array4<amrex::Real const> const& f,
+                                   amrex::IntVect const& iv, amrex::IntVect const& iv_p,
+                                   const amrex::Real w, const int icomp,
+                                   const amrex::Real gamma_boost, const amrex::Real beta_boost)
+    {
+        auto val = [&] (int n) { return (1._rt - w) * f(iv, n) + w * f(iv_p, n); };
+        constexpr amrex::Real clight = PhysConst::c;
+        constexpr amrex::Real inv_clight = 1._rt/PhysConst::c;
+        switch (icomp) {
+            case 0: return gamma_boost * ( val(0) + beta_boost * clight * val(4) );     // Ex
+            case 1: return gamma_boost * ( val(1) - beta_boost * clight * val(3) );     // Ey
+            case 3: return gamma_boost * ( val(3) - beta_boost * inv_clight * val(1) ); // Bx
+            case 4: return gamma_boost * ( val(4) + beta_boost * inv_clight * val(0) ); // By
+            case 8: return gamma_boost * ( val(8) + beta_boost * clight * val(9) );     // jz
+            case 9: return gamma_boost * ( val(9) + beta_boost * inv_clight * val(8) ); // rho
+            // Ez, Bz, jx and jy are not changed by the transform
+            default: return val(icomp);
+        }
+    }
+}
+
 BackTransformFunctor::BackTransformFunctor (amrex::MultiFab const * mf_src, int lev,
                                             const int ncomp, const int num_buffers,
                                             amrex::Vector< std::string > varnames,
+                                            const bool reuse_slice_plans,
                                             const amrex::IntVect crse_ratio)
-    : ComputeDiagFunctor(ncomp, crse_ratio), m_mf_src(mf_src), m_lev(lev), m_num_buffers(num_buffers), m_varnames(varnames)
+    : ComputeDiagFunctor(ncomp, crse_ratio), m_mf_src(mf_src), m_lev(lev), m_num_buffers(num_buffers), m_varnames(varnames),
+      m_reuse_slice_plans(reuse_slice_plans)
 {
     InitData();
 }
@@ -43,9 +81,38 @@ BackTransformFunctor::BackTransformFunctor (amrex::MultiFab const * mf_src, int
 void
 BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const int i_buffer) const
 {
+    // Nothing to do if this buffer was already transformed by BackTransformBuffers
+    if (m_transformed_in_batch[i_buffer] == 1) return;
+
     // Perform back-transformation only if z slice is within the domain stored as 0/1
     // in m_perform_backtransform[i_buffer]
-    if ( m_perform_backtransform[i_buffer] == 1) {
+    if ( m_perform_backtransform[i_buffer] == 1 && m_reuse_slice_plans) {
+        amrex::MultiFab& tmp = SliceWithPlan(mf_dst, i_buffer);
+        // Cherry pick the user-defined fields from the slice to mf_dst
+        const int k_lab = m_k_index_zlab[i_buffer];
+        const int ncomp_dst = mf_dst.nComp();
+        int const* field_map_ptr = m_d_map_varnames.dataPtr();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(tmp, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& tbx = mfi.tilebox();
+            amrex::Array4<amrex::Real const> src_arr = tmp.const_array(mfi);
+            amrex::Array4<amrex::Real> dst_arr = mf_dst.array(mfi);
+            amrex::ParallelFor( tbx, ncomp_dst,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+                {
+                    const int icomp = field_map_ptr[n];
+                    // The slice is at index 0 along the moving direction
+#if defined(WARPX_DIM_3D)
+                    dst_arr(i, j, k_lab, n) = src_arr(i, j, k, icomp);
+#else
+                    dst_arr(i, k_lab, k, n) = src_arr(i, j, k, icomp);
+#endif
+                } );
+        }
+    } else if ( m_perform_backtransform[i_buffer] == 1) {
         auto& warpx = WarpX::GetInstance();
         auto geom = warpx.Geom(m_lev);
         amrex::Real gamma_boost = warpx.gamma_boost;
@@ -131,6 +198,286 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
 
 }
 
+void
+BackTransformFunctor::BackTransformBuffers (amrex::Vector<amrex::MultiFab*> const& mf_dst) const
+{
+    auto& warpx = WarpX::GetInstance();
+    const amrex::Geometry& geom = warpx.Geom(m_lev);
+    const amrex::Real gamma_boost = warpx.gamma_boost;
+    const int moving_window_dir = warpx.moving_window_dir;
+    const amrex::Real beta_boost = std::sqrt( 1._rt - 1._rt/( gamma_boost * gamma_boost) );
+    const amrex::Real dx = geom.CellSize(moving_window_dir);
+    const int ncomp_dst = static_cast<int>(m_map_varnames.size());
+    BatchPlan& plan = m_batch_plan;
+
+    // Buffers to transform, and their slice number among the distinct z-boost locations
+    amrex::Vector<int> buffers;
+    amrex::Vector<int> slots;
+    amrex::Vector<amrex::Real> slice_z;
+    for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
+        if (m_perform_backtransform[i_buffer] == 0) continue;
+        const auto it = std::find(slice_z.begin(), slice_z.end(), m_current_z_boost[i_buffer]);
+        buffers.push_back(i_buffer);
+        slots.push_back(static_cast<int>(it - slice_z.begin()));
+        if (it == slice_z.end()) slice_z.push_back(m_current_z_boost[i_buffer]);
+    }
+    if (buffers.empty()) return;
+
+    // index of each slice in the boosted frame, and weight of the cell i_boost+1
+    // for the linear interpolation (same as amrex::get_slice_data)
+    const int nslices = static_cast<int>(slice_z.size());
+    amrex::Vector<int> i_boost(nslices);
+    amrex::Vector<amrex::Real> w_hi(nslices);
+    for (int s = 0; s < nslices; ++s) {
+        const amrex::Real z_index = ( slice_z[s] - geom.ProbLo(moving_window_dir) ) / dx;
+        i_boost[s] = static_cast<int>( z_index );
+        w_hi[s] = z_index - i_boost[s];
+    }
+
+    // Boxes of m_mf_src that contain each slice
+    const amrex::BoxArray& src_ba = m_mf_src->boxArray();
+    const amrex::DistributionMapping& src_dm = m_mf_src->DistributionMap();
+    amrex::Vector<int> src_index;
+    amrex::Vector<int> src_slot;
+    for (int s = 0; s < nslices; ++s) {
+        for (int i = 0; i < static_cast<int>(src_ba.size()); ++i) {
+            const amrex::Box& bx = src_ba[i];
+            if (bx.smallEnd(moving_window_dir) <= i_boost[s] && i_boost[s] <= bx.bigEnd(moving_window_dir)) {
+                src_index.push_back(i);
+                src_slot.push_back(s);
+            }
+        }
+    }
+
+    // (Re)build the stack of slices of m_mf_src if needed
+    if (!plan.src_stack || src_index != plan.src_index || src_slot != plan.src_slot
+        || !(plan.src_ba == src_ba) || !(plan.src_dm == src_dm))
+    {
+        amrex::BoxList bl(src_ba.ixType());
+        amrex::Vector<int> pmap;
+        for (int ib = 0; ib < static_cast<int>(src_index.size()); ++ib) {
+            amrex::Box bx = src_ba[src_index[ib]];
+            bx.setSmall(moving_window_dir, src_slot[ib]);
+            bx.setBig(moving_window_dir, src_slot[ib]);
+            bl.push_back(bx);
+            pmap.push_back(src_dm[src_index[ib]]);
+        }
+        plan.src_ba = src_ba;
+        plan.src_dm = src_dm;
+        plan.src_index = src_index;
+        plan.src_slot = src_slot;
+        plan.src_stack = std::make_unique<amrex::MultiFab>(
+            amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)), ncomp_dst, 0);
+    }
+
+    // Extract all the slices, and Lorentz-transform the user-requested components only
+    amrex::MultiFab& src_stack = *plan.src_stack;
+    int const* field_map_ptr = m_d_map_varnames.dataPtr();
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(src_stack, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box& tbx = mfi.tilebox();
+        const int isrc = plan.src_index[mfi.index()];
+        const int s = plan.src_slot[mfi.index()];
+        const int ib = i_boost[s];
+        amrex::Array4<amrex::Real const> const full_arr = m_mf_src->const_array(isrc);
+        amrex::Array4<amrex::Real> const stack_arr = src_stack.array(mfi);
+        // The cell i_boost+1 is only used if it is in the fab (including guard cells)
+        amrex::IntVect iv_hi = m_mf_src->fabbox(isrc).smallEnd();
+        iv_hi[moving_window_dir] = ib + 1;
+        const amrex::Real w = m_mf_src->fabbox(isrc).contains(iv_hi) ? w_hi[s] : 0._rt;
+        const int dir = moving_window_dir;
+        amrex::ParallelFor( tbx, ncomp_dst,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+                iv[dir] = ib;
+                amrex::IntVect iv_p = iv;
+                iv_p[dir] = (w > 0._rt) ? ib + 1 : ib;
+                stack_arr(i, j, k, n) = LabFrameComponent(full_arr, iv, iv_p, w, field_map_ptr[n],
+                                                          gamma_boost, beta_boost);
+            } );
+    }
+
+    // Slices of the buffer boxes, with the distribution maps of the destination multifabs
+    amrex::Vector<amrex::Box> dst_boxes;
+    amrex::Vector<amrex::DistributionMapping> dst_dms;
+    for (int ib = 0; ib < static_cast<int>(buffers.size()); ++ib) {
+        amrex::Box bx = m_buffer_box[buffers[ib]];
+        bx.setSmall(moving_window_dir, slots[ib]);
+        bx.setBig(moving_window_dir, slots[ib]);
+        dst_boxes.push_back(bx);
+        dst_dms.push_back(mf_dst[buffers[ib]]->DistributionMap());
+    }
+    bool same_dst = plan.dst_stack && buffers == plan.buffers && slots == plan.slots
+                    && dst_boxes == plan.dst_boxes;
+    for (int ib = 0; same_dst && ib < static_cast<int>(buffers.size()); ++ib) {
+        same_dst = (dst_dms[ib] == plan.dst_dms[ib]);
+    }
+    if (!same_dst)
+    {
+        amrex::BoxList bl;
+        amrex::Vector<int> pmap;
+        plan.dst_buffer.clear();
+        plan.dst_index.clear();
+        for (int ib = 0; ib < static_cast<int>(buffers.size()); ++ib) {
+            amrex::BoxArray slice_ba(dst_boxes[ib]);
+            slice_ba.maxSize( m_max_box_size );
+            for (int j = 0; j < static_cast<int>(slice_ba.size()); ++j) {
+                bl.push_back(slice_ba[j]);
+                pmap.push_back(dst_dms[ib][j]);
+                plan.dst_buffer.push_back(buffers[ib]);
+                plan.dst_index.push_back(j);
+            }
+        }
+        plan.buffers = buffers;
+        plan.slots = slots;
+        plan.dst_boxes = dst_boxes;
+        plan.dst_dms = dst_dms;
+        plan.dst_stack = std::make_unique<amrex::MultiFab>(
+            amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)), ncomp_dst, 0);
+    }
+
+    // Copy all the slices to the distribution maps of the buffers at once
+    amrex::MultiFab& dst_stack = *plan.dst_stack;
+    dst_stack.setVal(0.0);
+    ablastr::utils::communication::ParallelCopy(dst_stack, src_stack, 0, 0, ncomp_dst,
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                WarpX::do_single_precision_comms);
+
+    // Scatter the slices in the buffers
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(dst_stack, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box& tbx = mfi.tilebox();
+        const int i_buffer = plan.dst_buffer[mfi.index()];
+        const int k_lab = m_k_index_zlab[i_buffer];
+        amrex::Array4<amrex::Real const> const src_arr = dst_stack.const_array(mfi);
+        amrex::Array4<amrex::Real> const dst_arr = mf_dst[i_buffer]->array(plan.dst_index[mfi.index()]);
+        amrex::ParallelFor( tbx, ncomp_dst,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n)
+            {
+#if defined(WARPX_DIM_3D)
+                dst_arr(i, j, k_lab, n) = src_arr(i, j, k, n);
+#else
+                dst_arr(i, k_lab, k, n) = src_arr(i, j, k, n);
+#endif
+            } );
+    }
+
+    for (const int i_buffer : buffers) m_transformed_in_batch[i_buffer] = 1;
+}
+
+amrex::MultiFab&
+BackTransformFunctor::SliceWithPlan (amrex::MultiFab const& mf_dst, const int i_buffer) const
+{
+    auto& warpx = WarpX::GetInstance();
+    const amrex::Geometry& geom = warpx.Geom(m_lev);
+    const amrex::Real gamma_boost = warpx.gamma_boost;
+    const int moving_window_dir = warpx.moving_window_dir;
+    const amrex::Real beta_boost = std::sqrt( 1._rt - 1._rt/( gamma_boost * gamma_boost) );
+    const int ncomp = m_mf_src->nComp();
+    SlicePlan& plan = m_slice_plans[i_buffer];
+
+    // index corresponding to z_boost location in the boost-frame, and weight of the
+    // cell i_boost+1 for the linear interpolation (same as amrex::get_slice_data)
+    const amrex::Real dx = geom.CellSize(moving_window_dir);
+    const amrex::Real z_index = ( m_current_z_boost[i_buffer]
+                                  - geom.ProbLo(moving_window_dir) ) / dx;
+    const int i_boost = static_cast<int>( z_index );
+    const amrex::Real w_hi = z_index - i_boost;
+
+    // Boxes of m_mf_src that contain the slice
+    const amrex::BoxArray& src_ba = m_mf_src->boxArray();
+    const amrex::DistributionMapping& src_dm = m_mf_src->DistributionMap();
+    amrex::Vector<int> src_indices;
+    for (int i = 0; i < static_cast<int>(src_ba.size()); ++i) {
+        const amrex::Box& bx = src_ba[i];
+        if (bx.smallEnd(moving_window_dir) <= i_boost && i_boost <= bx.bigEnd(moving_window_dir)) {
+            src_indices.push_back(i);
+        }
+    }
+
+    // (Re)build the slice of m_mf_src if the slice crossed a box boundary,
+    // or if the boxes of m_mf_src were redistributed
+    if (!plan.slice || src_indices != plan.src_indices
+        || !(plan.src_ba == src_ba) || !(plan.src_dm == src_dm))
+    {
+        amrex::BoxList bl(src_ba.ixType());
+        amrex::Vector<int> pmap;
+        for (const int i : src_indices) {
+            amrex::Box bx = src_ba[i];
+            bx.setSmall(moving_window_dir, 0);
+            bx.setBig(moving_window_dir, 0);
+            bl.push_back(bx);
+            pmap.push_back(src_dm[i]);
+        }
+        plan.src_ba = src_ba;
+        plan.src_dm = src_dm;
+        plan.src_indices = src_indices;
+        plan.slice = std::make_unique<amrex::MultiFab>(
+            amrex::BoxArray(std::move(bl)), amrex::DistributionMapping(std::move(pmap)), ncomp, 0);
+    }
+
+    // Fill the slice with the data interpolated between the cells i_boost and i_boost+1
+    amrex::MultiFab& slice = *plan.slice;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(slice, TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const amrex::Box& tbx = mfi.tilebox();
+        const int src_index = plan.src_indices[mfi.index()];
+        amrex::Array4<amrex::Real const> const full_arr = m_mf_src->const_array(src_index);
+        amrex::Array4<amrex::Real> const slice_arr = slice.array(mfi);
+        // The cell i_boost+1 is only used if it is in the fab (including guard cells)
+        amrex::IntVect iv_hi = m_mf_src->fabbox(src_index).smallEnd();
+        iv_hi[moving_window_dir] = i_boost + 1;
+        const amrex::Real w = m_mf_src->fabbox(src_index).contains(iv_hi) ? w_hi : 0._rt;
+        const int dir = moving_window_dir;
+        const int ib = i_boost;
+        amrex::ParallelFor( tbx, ncomp,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+            {
+                amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+                iv[dir] = ib;
+                amrex::IntVect iv_p = iv;
+                iv_p[dir] = (w > 0._rt) ? ib + 1 : ib;
+                slice_arr(i, j, k, n) = (1._rt - w) * full_arr(iv, n) + w * full_arr(iv_p, n);
+            } );
+    }
+
+    // Perform in-place Lorentz-transform of all the fields stored in the slice.
+    LorentzTransformZ( slice, gamma_boost, beta_boost);
+
+    // Slice of the buffer box, at index 0, with the distribution map of the destination multifab
+    amrex::Box dst_box = m_buffer_box[i_buffer];
+    dst_box.setSmall(moving_window_dir, 0);
+    dst_box.setBig(moving_window_dir, 0);
+    if (!plan.dst_slice || dst_box != plan.dst_box || !(plan.dst_dm == mf_dst.DistributionMap()))
+    {
+        amrex::BoxArray slice_ba(dst_box);
+        slice_ba.maxSize( m_max_box_size );
+        plan.dst_box = dst_box;
+        plan.dst_dm = mf_dst.DistributionMap();
+        plan.dst_slice = std::make_unique<amrex::MultiFab>(slice_ba, plan.dst_dm, ncomp, 0);
+    }
+    amrex::MultiFab& tmp = *plan.dst_slice;
+    tmp.setVal(0.0);
+    // Since the BoxArrays and DistributionMappings of slice and tmp are reused,
+    // the communication metadata of this copy is cached by AMReX.
+    ablastr::utils::communication::ParallelCopy(tmp, slice, 0, 0, ncomp,
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                IntVect(AMREX_D_DECL(0, 0, 0)),
+                                                WarpX::do_single_precision_comms);
+    return tmp;
+}
+
 void
 BackTransformFunctor::PrepareFunctorData (int i_buffer,
                           bool z_slice_in_domain, amrex::Real current_z_boost,
@@ -141,6 +488,7 @@ BackTransformFunctor::PrepareFunctorData (int i_buffer,
     m_current_z_boost[i_buffer] = current_z_boost;
     m_k_index_zlab[i_buffer] = k_index_zlab;
     m_perform_backtransform[i_buffer] = 0;
+    m_transformed_in_batch[i_buffer] = 0;
     if (z_slice_in_domain == true and snapshot_full == 0) m_perform_backtransform[i_buffer] = 1;
     m_max_box_size = max_box_size;
 }
@@ -153,6 +501,7 @@ BackTransformFunctor::InitData ()
     m_current_z_boost.resize( m_num_buffers );
     m_perform_backtransform.resize( m_num_buffers );
     m_k_index_zlab.resize( m_num_buffers );
+    m_transformed_in_batch.resize( m_num_buffers, 0 );
     m_map_varnames.resize( m_varnames.size() );
 
     std::map<std::string, int> m_possible_fields_to_dump = {
@@ -173,6 +522,13 @@ BackTransformFunctor::InitData ()
         m_map_varnames[i] = m_possible_fields_to_dump[ m_varnames[i] ] ;
     }
 
+    m_slice_plans.resize( m_num_buffers );
+    m_d_map_varnames.resize( m_map_varnames.size() );
+    Gpu::copyAsync(Gpu::hostToDevice,
+                   m_map_varnames.begin(), m_map_varnames.end(),
+                   m_d_map_varnames.begin());
+    Gpu::synchronize();
+
 }
 
 void
@@ -11,6 +11,7 @@
 #endif
 #include "FlushFormats/FlushFormatPlotfile.H"
 #include "FlushFormats/FlushFormatSensei.H"
+#include "OutputCompression.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -375,7 +376,7 @@ Diagnostics::InitBaseData ()
         m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
-        m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
+        m_flush_format = std::make_unique<FlushFormatCheckpoint>(m_diag_name) ;
     } else if (m_format == "ascent"){
         m_flush_format = std::make_unique<FlushFormatAscent>();
     } else if (m_format == "sensei"){
@@ -399,6 +400,17 @@ Diagnostics::InitBaseData ()
             "unknown output format"));
     }
 
+    // the compression is done by the openPMD backend (see FlushFormatOpenPMD)
+    const OutputCompression compression(m_diag_name);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !(compression.CompressFieldsEnabled() && m_format != "openpmd"),
+        m_diag_name + ".compression.field_error_bound is only supported with the openpmd format");
+    if (compression.CompressParticlesEnabled() && m_format != "openpmd") {
+        ablastr::warn_manager::WMRecordWarning("Diagnostics",
+            m_diag_name + ".compression.particles is only supported with the openpmd format"
+            " and is ignored");
+    }
+
     // allocate vector of buffers then allocate vector of levels for each buffer
     m_mf_output.resize( m_num_buffers );
     for (int i = 0; i < m_num_buffers; ++i) {
@@ -467,6 +479,20 @@ Diagnostics::FilterComputePackFlush (int step, bool force_flush)
     MovingWindowAndGalileanDomainShift (step);
 
     if ( DoComputeAndPack (step, force_flush) ) {
+        // the species whose restart was deferred are read when first needed:
+        // all of them for checkpoints, otherwise the species that are output
+        // or deposited on the grid (rho_<species>, particle fields)
+        auto & mpc = WarpX::GetInstance().GetPartContainer();
+        if (m_format == "checkpoint") {
+            mpc.LoadDeferredSpecies();
+        } else {
+            std::vector<std::string> species = m_output_species_names;
+            species.insert(species.end(), m_pfield_species.begin(), m_pfield_species.end());
+            for (const int i : m_rho_per_species_index) {
+                species.push_back(m_all_species_names[i]);
+            }
+            if (!species.empty()) mpc.LoadDeferredSpecies(species);
+        }
         ComputeAndPack();
     }
 
@@ -5,24 +5,162 @@
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
+#include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <ablastr/warn_manager/WarnManager.H>
+
+#include <AMReX_AsyncOut.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
 using namespace amrex;
 
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+
+    using Hash = std::array<amrex::Long,3>;
+
+    /** Bits of the hash summed in each component of Hash: the sums do not
+     *  overflow for up to 2^39 values per MPI rank */
+    constexpr std::uint64_t hash_mask = (std::uint64_t(1) << 24) - 1;
+
+    /** Mixing function (splitmix64 finalizer) */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    std::uint64_t Mix (std::uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /** Bit pattern of a floating-point value */
+    template <typename T>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    std::uint64_t Bits (T v)
+    {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "unsupported type");
+        if constexpr (sizeof(T) == 8) {
+            std::uint64_t b;
+            memcpy(&b, &v, sizeof(T));
+            return b;
+        } else {
+            std::uint32_t b;
+            memcpy(&b, &v, sizeof(T));
+            return b;
+        }
+    }
+
+    /** \brief Hash of the data of a MultiFab held by this MPI rank (including the guard cells).
+     *
+     * The hash of each value depends on its bits and its index, and the hashes are
+     * summed, so that the result does not depend on the order of the boxes.
+     */
+    Hash HashMultiFab (const amrex::MultiFab& mf)
+    {
+        const int ncomp = mf.nComp();
+        amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Long, amrex::Long, amrex::Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        for (amrex::MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            amrex::Array4<amrex::Real const> const arr = mf.const_array(mfi);
+            reduce_op.eval(mfi.fabbox(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const std::uint64_t index = Mix(
+                        (static_cast<std::uint64_t>(i & 0xFFFFF) << 40) |
+                        (static_cast<std::uint64_t>(j & 0xFFFFF) << 20) |
+                         static_cast<std::uint64_t>(k & 0xFFFFF));
+                    std::uint64_t h = index;
+                    for (int n = 0; n < ncomp; ++n) {
+                        h = Mix(h ^ Bits(arr(i, j, k, n)));
+                    }
+                    return {static_cast<amrex::Long>(h & hash_mask),
+                            static_cast<amrex::Long>((h >> 24) & hash_mask),
+                            static_cast<amrex::Long>((h >> 40) & hash_mask)};
+                });
+        }
+        const auto r = reduce_data.value();
+        return {amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r)};
+    }
+
+    /** \brief Hash of the particles of a species held by this MPI rank: id, cpu,
+     *  position and all (compile-time and runtime) real and int components. */
+    Hash HashParticles (WarpXParticleContainer& pc)
+    {
+        amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Long, amrex::Long, amrex::Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        for (int lev = 0; lev <= pc.finestLevel(); ++lev) {
+            for (WarpXParIter pti(pc, lev); pti.isValid(); ++pti) {
+                const auto ptd = pti.GetParticleTile().getConstParticleTileData();
+                const long np = pti.numParticles();
+                reduce_op.eval(np, reduce_data,
+                    [=] AMREX_GPU_DEVICE (long ip) -> ReduceTuple
+                    {
+                        const auto& p = ptd.m_aos[ip];
+                        std::uint64_t h = Mix(
+                            (static_cast<std::uint64_t>(p.id()) << 24) ^
+                             static_cast<std::uint64_t>(p.cpu()));
+                        for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                            h = Mix(h ^ Bits(p.pos(d)));
+                        }
+                        for (int n = 0; n < PIdx::nattribs; ++n) {
+                            h = Mix(h ^ Bits(ptd.m_rdata[n][ip]));
+                        }
+                        for (int n = 0; n < ptd.m_num_runtime_real; ++n) {
+                            h = Mix(h ^ Bits(ptd.m_runtime_rdata[n][ip]));
+                        }
+                        for (int n = 0; n < ptd.m_num_runtime_int; ++n) {
+                            h = Mix(h ^ static_cast<std::uint32_t>(ptd.m_runtime_idata[n][ip]));
+                        }
+                        return {static_cast<amrex::Long>(h & hash_mask),
+                                static_cast<amrex::Long>((h >> 24) & hash_mask),
+                                static_cast<amrex::Long>((h >> 40) & hash_mask)};
+                    });
+            }
+        }
+        const auto r = reduce_data.value();
+        return {amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r)};
+    }
+}
+
+FlushFormatCheckpoint::FlushFormatCheckpoint (const std::string& diag_name)
+{
+    ParmParse pp_diag_name(diag_name);
+
+    pp_diag_name.query("checkpoint_base_interval", m_base_interval);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_base_interval >= 1,
+        diag_name + ".checkpoint_base_interval must be at least 1");
+
+    pp_diag_name.query("async_write", m_async_write);
+    if (m_async_write && !amrex::AsyncOut::UseAsyncOut()) {
+        ablastr::warn_manager::WMRecordWarning("Diagnostics",
+            diag_name + ".async_write requires amrex.async_out = 1;"
+            " the checkpoints are written synchronously");
+        m_async_write = false;
+    }
 }
 
 void
@@ -44,6 +182,10 @@ FlushFormatCheckpoint::WriteToFile (
 
     auto & warpx = WarpX::GetInstance();
 
+    // the reduced diagnostics up to the checkpoint must be on disk
+    // when restarting from it
+    warpx.reduced_diags->FlushBuffers();
+
     VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::NoFabHeader_v1);
 
@@ -52,95 +194,92 @@ FlushFormatCheckpoint::WriteToFile (
     amrex::Print() << Utils::TextMsg::Info(
         "Writing checkpoint " + checkpointname);
 
+    // With checkpoint_base_interval > 1, a full checkpoint is written every
+    // checkpoint_base_interval checkpoints, and incremental checkpoints in between
+    const bool is_base = (m_base_interval == 1) || m_base_name.empty()
+        || (m_num_checkpoints % m_base_interval == 0);
+    if (is_base) {
+        m_base_name = checkpointname;
+        m_base_hashes.clear();
+    }
+    m_skipped.clear();
+    ++m_num_checkpoints;
+
     // const int nlevels = finestLevel()+1;
     amrex::PreBuildDirectorHierarchy(checkpointname, default_level_prefix, nlev, true);
 
+    const auto WriteField = [&] (const amrex::MultiFab& mf, int lev, const std::string& name)
+    {
+        if (m_base_interval > 1) {
+            const std::string key = amrex::Concatenate(default_level_prefix, lev, 1) + "/" + name;
+            if (!MustWrite(key, HashMultiFab(mf), is_base)) return;
+        }
+        const std::string path =
+            amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, name);
+        if (m_async_write) {
+            // copy of the data, written in the background
+            VisMF::AsyncWrite(mf, path);
+        } else {
+            VisMF::Write(mf, path);
+        }
+    };
+
     WriteWarpXHeader(checkpointname, geom);
 
     WriteJobInfo(checkpointname);
 
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(warpx.getEfield_fp(lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(warpx.getEfield_fp(lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(warpx.getEfield_fp(lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
+        WriteField(warpx.getEfield_fp(lev, 0), lev, "Ex_fp");
+        WriteField(warpx.getEfield_fp(lev, 1), lev, "Ey_fp");
+        WriteField(warpx.getEfield_fp(lev, 2), lev, "Ez_fp");
+        WriteField(warpx.getBfield_fp(lev, 0), lev, "Bx_fp");
+        WriteField(warpx.getBfield_fp(lev, 1), lev, "By_fp");
+        WriteField(warpx.getBfield_fp(lev, 2), lev, "Bz_fp");
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Write(warpx.getEfield_avg_fp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
-            VisMF::Write(warpx.getEfield_avg_fp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
-            VisMF::Write(warpx.getEfield_avg_fp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
-
-            VisMF::Write(warpx.getBfield_avg_fp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
-            VisMF::Write(warpx.getBfield_avg_fp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
-            VisMF::Write(warpx.getBfield_avg_fp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
+            WriteField(warpx.getEfield_avg_fp(lev, 0), lev, "Ex_avg_fp");
+            WriteField(warpx.getEfield_avg_fp(lev, 1), lev, "Ey_avg_fp");
+            WriteField(warpx.getEfield_avg_fp(lev, 2), lev, "Ez_avg_fp");
+
+            WriteField(warpx.getBfield_avg_fp(lev, 0), lev, "Bx_avg_fp");
+            WriteField(warpx.getBfield_avg_fp(lev, 1), lev, "By_avg_fp");
+            WriteField(warpx.getBfield_avg_fp(lev, 2), lev, "Bz_avg_fp");
         }
 
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(warpx.getcurrent_fp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(warpx.getcurrent_fp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(warpx.getcurrent_fp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
+            WriteField(warpx.getcurrent_fp(lev, 0), lev, "jx_fp");
+            WriteField(warpx.getcurrent_fp(lev, 1), lev, "jy_fp");
+            WriteField(warpx.getcurrent_fp(lev, 2), lev, "jz_fp");
         }
 
         if (lev > 0)
         {
-            VisMF::Write(warpx.getEfield_cp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(warpx.getEfield_cp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(warpx.getEfield_cp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
+            WriteField(warpx.getEfield_cp(lev, 0), lev, "Ex_cp");
+            WriteField(warpx.getEfield_cp(lev, 1), lev, "Ey_cp");
+            WriteField(warpx.getEfield_cp(lev, 2), lev, "Ez_cp");
+            WriteField(warpx.getBfield_cp(lev, 0), lev, "Bx_cp");
+            WriteField(warpx.getBfield_cp(lev, 1), lev, "By_cp");
+            WriteField(warpx.getBfield_cp(lev, 2), lev, "Bz_cp");
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Write(warpx.getEfield_avg_cp(lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
-                VisMF::Write(warpx.getEfield_avg_cp(lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
-                VisMF::Write(warpx.getEfield_avg_cp(lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
-
-                VisMF::Write(warpx.getBfield_avg_cp(lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
-                VisMF::Write(warpx.getBfield_avg_cp(lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
-                VisMF::Write(warpx.getBfield_avg_cp(lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
+                WriteField(warpx.getEfield_avg_cp(lev, 0), lev, "Ex_avg_cp");
+                WriteField(warpx.getEfield_avg_cp(lev, 1), lev, "Ey_avg_cp");
+                WriteField(warpx.getEfield_avg_cp(lev, 2), lev, "Ez_avg_cp");
+
+                WriteField(warpx.getBfield_avg_cp(lev, 0), lev, "Bx_avg_cp");
+                WriteField(warpx.getBfield_avg_cp(lev, 1), lev, "By_avg_cp");
+                WriteField(warpx.getBfield_avg_cp(lev, 2), lev, "Bz_avg_cp");
             }
 
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(warpx.getcurrent_cp(lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(warpx.getcurrent_cp(lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(warpx.getcurrent_cp(lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
+                WriteField(warpx.getcurrent_cp(lev, 0), lev, "jx_cp");
+                WriteField(warpx.getcurrent_cp(lev, 1), lev, "jy_cp");
+                WriteField(warpx.getcurrent_cp(lev, 2), lev, "jz_cp");
             }
         }
 
@@ -158,10 +297,18 @@ FlushFormatCheckpoint::WriteToFile (
         }
     }
 
-    CheckpointParticles(checkpointname, particle_diags);
+    CheckpointParticles(checkpointname, particle_diags, is_base);
 
     WriteDMaps(checkpointname, nlev);
 
+    if (!is_base) {
+        WriteIncrementalManifest(checkpointname);
+        amrex::Print() << Utils::TextMsg::Info(
+            "Incremental checkpoint " + checkpointname + ": "
+            + std::to_string(m_skipped.size()) + " unchanged fields and species read from "
+            + m_base_name + " at restart");
+    }
+
     VisMF::SetHeaderVersion(current_version);
 
 }
@@ -169,11 +316,17 @@ FlushFormatCheckpoint::WriteToFile (
 void
 FlushFormatCheckpoint::CheckpointParticles (
     const std::string& dir,
-    const amrex::Vector<ParticleDiag>& particle_diags) const
+    const amrex::Vector<ParticleDiag>& particle_diags,
+    bool is_base) const
 {
     for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         WarpXParticleContainer* pc = particle_diags[i].getParticleContainer();
 
+        if (m_base_interval > 1 &&
+            !MustWrite("particles/" + particle_diags[i].getSpeciesName(), HashParticles(*pc), is_base)) {
+            continue;
+        }
+
         Vector<std::string> real_names;
         Vector<std::string> int_names;
         Vector<int> int_flags;
@@ -207,8 +360,16 @@ FlushFormatCheckpoint::CheckpointParticles (
 void
 FlushFormatCheckpoint::WriteDMaps (const std::string& dir, int nlev) const
 {
+    auto & warpx = WarpX::GetInstance();
+
+    // number of particles in each box, used to compute the costs of the boxes
+    // when restarting on a different number of MPI ranks
+    amrex::Vector<amrex::Vector<amrex::Long>> num_particles(nlev);
+    for (int lev = 0; lev < nlev; ++lev) {
+        num_particles[lev] = warpx.GetPartContainer().NumberOfParticlesInGrid(lev);
+    }
+
     if (ParallelDescriptor::IOProcessor()) {
-        auto & warpx = WarpX::GetInstance();
         for (int lev = 0; lev < nlev; ++lev) {
             std::string DMFileName = dir;
             if (!DMFileName.empty() && DMFileName[DMFileName.size()-1] != '/') {DMFileName += '/';}
@@ -229,6 +390,62 @@ FlushFormatCheckpoint::WriteDMaps (const std::string& dir, int nlev) const
                 DMFile.good(),
                 "FlushFormatCheckpoint::WriteDMaps: problem writing DMFile"
             );
+
+            const std::string NumParticlesFileName = amrex::Concatenate(dir + "/Level_", lev, 1)
+                + "/NumParticles";
+            std::ofstream NumParticlesFile(NumParticlesFileName.c_str(), std::ios::out|std::ios::trunc);
+            if (!NumParticlesFile.good()) { amrex::FileOpenFailed(NumParticlesFileName); }
+
+            NumParticlesFile << num_particles[lev].size() << "\n";
+            for (const auto np : num_particles[lev]) { NumParticlesFile << np << "\n"; }
+
+            NumParticlesFile.flush();
+            NumParticlesFile.close();
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                NumParticlesFile.good(),
+                "FlushFormatCheckpoint::WriteDMaps: problem writing NumParticlesFile"
+            );
         }
     }
 }
+
+void
+FlushFormatCheckpoint::WriteIncrementalManifest (const std::string& dir) const
+{
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::string manifest_name = dir + "/WarpXIncremental";
+        std::ofstream manifest(manifest_name.c_str(), std::ios::out|std::ios::trunc);
+        if (!manifest.good()) { amrex::FileOpenFailed(manifest_name); }
+
+        // the base checkpoint is written with the same prefix, i.e. in the same
+        // directory: store its path relative to the incremental checkpoint, so
+        // that the checkpoints can be moved and restarted from any directory
+        const auto slash = m_base_name.find_last_of('/');
+        manifest << "../" << ((slash == std::string::npos) ? m_base_name : m_base_name.substr(slash+1))
+                 << "\n";
+        manifest << m_skipped.size() << "\n";
+        for (const auto& key : m_skipped) { manifest << key << "\n"; }
+
+        manifest.flush();
+        manifest.close();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            manifest.good(),
+            "FlushFormatCheckpoint::WriteIncrementalManifest: problem writing " + manifest_name
+        );
+    }
+}
+
+bool
+FlushFormatCheckpoint::MustWrite (const std::string& key, const std::array<amrex::Long,3>& hash,
+                                  bool is_base) const
+{
+    if (is_base) {
+        m_base_hashes[key] = hash;
+        return true;
+    }
+    const auto it = m_base_hashes.find(key);
+    bool unchanged = (it != m_base_hashes.end()) && (it->second == hash);
+    ParallelDescriptor::ReduceBoolAnd(unchanged);
+    if (unchanged) m_skipped.push_back(key);
+    return !unchanged;
+}
@@ -20,6 +20,7 @@ using namespace amrex;
 
 
 FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
+    : m_compression(diag_name)
 {
     ParmParse pp_diag_name(diag_name);
     // Which backend to use (ADIOS, ADIOS2 or HDF5). Default depends on what is available
@@ -100,7 +101,9 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
     encoding, openpmd_backend,
     operator_type, operator_parameters,
     engine_type, engine_parameters,
-    warpx.getPMLdirections()
+    warpx.getPMLdirections(),
+    m_compression.ParticleOperatorJSON(),
+    m_compression.FieldCompressor()
   );
 }
 
@@ -133,9 +136,16 @@ FlushFormatOpenPMD::WriteToFile (
     // Set step and output directory name.
     m_OpenPMDPlotWriter->SetStep(output_iteration, prefix, file_min_digits, isBTD);
 
+    // error bounds of the lossy compression of the fields
+    amrex::Vector<amrex::Real> field_error_bounds;
+    if (m_compression.CompressFieldsEnabled()) {
+        field_error_bounds = m_compression.FieldErrorBounds(mf, output_levels);
+    }
+
     // fields: only dumped for coarse level
     m_OpenPMDPlotWriter->WriteOpenPMDFieldsAll(
-        varnames, mf, geom, output_levels, output_iteration, time, isBTD, full_BTD_snapshot);
+        varnames, mf, geom, output_levels, output_iteration, time, isBTD, full_BTD_snapshot,
+        field_error_bounds);
 
     // particles: all (reside only on locally finest level)
     m_OpenPMDPlotWriter->WriteOpenPMDParticles(particle_diags, use_pinned_pc, isBTD, isLastBTDFlush, totalParticlesFlushedAlready);
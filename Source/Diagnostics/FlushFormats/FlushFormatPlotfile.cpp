@@ -351,12 +351,12 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
                                    compileParser<ParticleDiag::m_nvars>
                                        (particle_diags[i].m_particle_filter_parser.get()),
                                    pc->getMass());
-        parser_filter.m_units = InputUnits::SI;
+        // the filters see the live particles, which are in WarpX units
+        parser_filter.m_units = InputUnits::WarpX;
         GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
                                              particle_diags[i].m_diag_domain);
 
         if (!isBTD) {
-            particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
             using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
             tmp.copyParticles(*pc,
                               [=] AMREX_GPU_HOST_DEVICE (const SrcData& src, int ip, const amrex::RandomEngine& engine)
@@ -365,12 +365,12 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
                 return random_filter(p, engine) * uniform_filter(p, engine)
                     * parser_filter(p, engine) * geometry_filter(p, engine);
             }, true);
-            particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
         } else {
             PinnedMemoryParticleContainer* pinned_pc = particle_diags[i].getPinnedParticleContainer();
             tmp.copyParticles(*pinned_pc, true);
-            particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
         }
+        // convert only the selected copy: the live species is never modified
+        particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
         // real_names contains a list of all particle attributes.
         // real_flags & int_flags are 1 or 0, whether quantity is dumped or not.
         tmp.WritePlotFile(
@@ -0,0 +1,102 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "OutputCompression.H"
+
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
+
+#include <AMReX_BLassert.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <ios>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+OutputCompression::OutputCompression (const std::string& diag_name)
+{
+    ParmParse pp_diag_name(diag_name);
+
+    queryWithParser(pp_diag_name, "compression.field_error_bound", m_field_error_bound);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_field_error_bound >= 0._rt,
+        diag_name + ".compression.field_error_bound must be non-negative");
+    std::string error_mode = "relative";
+    pp_diag_name.query("compression.field_error_mode", error_mode);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(error_mode == "relative" || error_mode == "absolute",
+        diag_name + ".compression.field_error_mode must be relative or absolute");
+    m_relative_error_bound = (error_mode == "relative");
+    pp_diag_name.query("compression.fields", m_field_compressor);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_field_compressor == "zfp" || m_field_compressor == "sz",
+        diag_name + ".compression.fields must be zfp or sz");
+
+    std::string particle_compressor = "none";
+    pp_diag_name.query("compression.particles", particle_compressor);
+    const std::vector<std::string> supported_compressors =
+        {"none", "blosclz", "lz4", "lz4hc", "zlib", "zstd"};
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        std::find(supported_compressors.begin(), supported_compressors.end(), particle_compressor)
+        != supported_compressors.end(),
+        diag_name + ".compression.particles must be one of none, blosclz, lz4, lz4hc, zlib, zstd");
+    if (particle_compressor != "none") m_particle_compressor = particle_compressor;
+    pp_diag_name.query("compression.particles_clevel", m_particle_clevel);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_particle_clevel >= 0 && m_particle_clevel <= 9,
+        diag_name + ".compression.particles_clevel must be between 0 and 9");
+
+    if (CompressFieldsEnabled()) {
+        std::ostringstream msg;
+        msg << diag_name << ": the fields are compressed with " << m_field_compressor
+            << " and a" << (m_relative_error_bound ? " relative" : "n absolute")
+            << " error bound of " << std::scientific << m_field_error_bound;
+        amrex::Print() << Utils::TextMsg::Info(msg.str());
+    }
+}
+
+amrex::Vector<amrex::Real>
+OutputCompression::FieldErrorBounds (amrex::Vector<amrex::MultiFab> const& mf, int nlev) const
+{
+    WARPX_PROFILE("OutputCompression::FieldErrorBounds()");
+
+    nlev = std::min(nlev, static_cast<int>(mf.size()));
+    if (nlev == 0) return {};
+    const int ncomp = mf[0].nComp();
+
+    // Error bound of each component
+    amrex::Vector<amrex::Real> error_bound(ncomp, m_field_error_bound);
+    if (m_relative_error_bound) {
+        amrex::Vector<amrex::Real> vmin(ncomp, std::numeric_limits<amrex::Real>::max());
+        amrex::Vector<amrex::Real> vmax(ncomp, std::numeric_limits<amrex::Real>::lowest());
+        for (int lev = 0; lev < nlev; ++lev) {
+            for (int comp = 0; comp < ncomp; ++comp) {
+                vmin[comp] = std::min(vmin[comp], mf[lev].min(comp, 0, true));
+                vmax[comp] = std::max(vmax[comp], mf[lev].max(comp, 0, true));
+            }
+        }
+        ParallelDescriptor::ReduceRealMin(vmin.data(), ncomp);
+        ParallelDescriptor::ReduceRealMax(vmax.data(), ncomp);
+        for (int comp = 0; comp < ncomp; ++comp) {
+            error_bound[comp] *= std::max(vmax[comp] - vmin[comp], 0._rt);
+        }
+    }
+
+    return error_bound;
+}
+
+std::string
+OutputCompression::ParticleOperatorJSON () const
+{
+    if (m_particle_compressor.empty()) return "";
+    return "{ \"type\": \"blosc\", \"parameters\": { \"compressor\": \"" + m_particle_compressor
+        + "\", \"clevel\": \"" + std::to_string(m_particle_clevel)
+        + "\", \"doshuffle\": \"BLOSC_SHUFFLE\" } }";
+}
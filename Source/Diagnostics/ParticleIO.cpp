@@ -27,13 +27,16 @@
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleIO.H>
+#include <AMReX_Print.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
 #include <array>
 #include <istream>
+#include <map>
 #include <memory>
 #include <string>
 #include <sstream>
@@ -118,99 +121,214 @@ PhysicalParticleContainer::WriteHeader (std::ostream& os) const
 }
 
 void
-MultiParticleContainer::Restart (const std::string& dir)
+MultiParticleContainer::Restart (const std::string& dir,
+                                 const std::map<std::string, std::string>& species_dir)
 {
+    // The next particle id is shared by all species, and is reset by each
+    // species restart: keep the largest one, in case the species are read
+    // from different checkpoints
+    amrex::Long next_id = 1;
+
     // note: all containers is sorted like this
     // - species_names
     // - lasers_names
     // we don't need to read back the laser particle charge/mass
     for (unsigned i = 0, n = species_names.size(); i < n; ++i) {
-        WarpXParticleContainer* pc = allcontainers.at(i).get();
-        std::string header_fn = dir + "/" + species_names[i] + "/Header";
+        const auto search_dir = species_dir.find(species_names[i]);
+        const std::string& pc_dir = (search_dir != species_dir.end()) ? search_dir->second : dir;
+
+        // the particles of this species are only read when they are first needed
+        if (allcontainers.at(i)->restart_deferred) {
+            CheckDeferredRestart(i);
+            m_deferred_restart[i] = pc_dir;
+            continue;
+        }
 
-        Vector<char> fileCharPtr;
-        ParallelDescriptor::ReadAndBcastFile(header_fn, fileCharPtr);
-        std::string fileCharPtrString(fileCharPtr.dataPtr());
-        std::istringstream is(fileCharPtrString, std::istringstream::in);
-        is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        RestartSpecies(i, pc_dir);
+        next_id = std::max(next_id, WarpXParticleContainer::ParticleType::UnprotectedNextID());
+    }
+    WarpXParticleContainer::ParticleType::NextID(next_id);
+
+    for (unsigned i = species_names.size(); i < species_names.size()+lasers_names.size(); ++i) {
+        allcontainers.at(i)->Restart(dir, lasers_names.at(i-species_names.size()));
+    }
+}
 
-        std::string line, word;
+void
+MultiParticleContainer::RestartSpecies (int i, const std::string& dir)
+{
+    WarpXParticleContainer* pc = allcontainers.at(i).get();
+    std::string header_fn = dir + "/" + species_names[i] + "/Header";
 
-        std::getline(is, line); // Version
-        std::getline(is, line); // SpaceDim
+    Vector<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(header_fn, fileCharPtr);
+    std::string fileCharPtrString(fileCharPtr.dataPtr());
+    std::istringstream is(fileCharPtrString, std::istringstream::in);
+    is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
 
-        int nr;
-        is >> nr;
+    std::string line, word;
 
-        std::vector<std::string> real_comp_names;
-        for (int j = 0; j < nr; ++j) {
-            std::string comp_name;
-            is >> comp_name;
-            real_comp_names.push_back(comp_name);
-        }
+    std::getline(is, line); // Version
+    std::getline(is, line); // SpaceDim
 
-        for (auto const& comp : pc->getParticleRuntimeComps()) {
-            auto search = std::find(real_comp_names.begin(), real_comp_names.end(), comp.first);
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                search != real_comp_names.end(),
-                "Species " + species_names[i]
-                + "needs runtime real component " +  comp.first
-                + ", but it was not found in the checkpoint file."
+    int nr;
+    is >> nr;
+
+    std::vector<std::string> real_comp_names;
+    for (int j = 0; j < nr; ++j) {
+        std::string comp_name;
+        is >> comp_name;
+        real_comp_names.push_back(comp_name);
+    }
+
+    for (auto const& comp : pc->getParticleRuntimeComps()) {
+        auto search = std::find(real_comp_names.begin(), real_comp_names.end(), comp.first);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            search != real_comp_names.end(),
+            "Species " + species_names[i]
+            + "needs runtime real component " +  comp.first
+            + ", but it was not found in the checkpoint file."
+        );
+    }
+
+    for (int j = PIdx::nattribs; j < nr; ++j) {
+        const auto& comp_name = real_comp_names[j];
+        auto current_comp_names = pc->getParticleComps();
+        auto search = current_comp_names.find(comp_name);
+        if (search == current_comp_names.end()) {
+            amrex::Print() << Utils::TextMsg::Info(
+                "Runtime real component " + comp_name
+                + " was found in the checkpoint file, but it has not been added yet. "
+                + " Adding it now."
             );
+            pc->AddRealComp(comp_name);
         }
+    }
 
-        for (int j = PIdx::nattribs; j < nr; ++j) {
-            const auto& comp_name = real_comp_names[j];
-            auto current_comp_names = pc->getParticleComps();
-            auto search = current_comp_names.find(comp_name);
-            if (search == current_comp_names.end()) {
-                amrex::Print() << Utils::TextMsg::Info(
-                    "Runtime real component " + comp_name
-                    + " was found in the checkpoint file, but it has not been added yet. "
-                    + " Adding it now."
-                );
-                pc->AddRealComp(comp_name);
-            }
-        }
+    int ni;
+    is >> ni;
 
-        int ni;
-        is >> ni;
+    std::vector<std::string> int_comp_names;
+    for (int j = 0; j < ni; ++j) {
+        std::string comp_name;
+        is >> comp_name;
+        int_comp_names.push_back(comp_name);
+    }
 
-        std::vector<std::string> int_comp_names;
-        for (int j = 0; j < ni; ++j) {
-            std::string comp_name;
-            is >> comp_name;
-            int_comp_names.push_back(comp_name);
-        }
+    for (auto const& comp : pc->getParticleRuntimeiComps()) {
+        auto search = std::find(int_comp_names.begin(), int_comp_names.end(), comp.first);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            search != int_comp_names.end(),
+            "Species " + species_names[i] + "needs runtime int component " + comp.first
+            + ", but it was not found in the checkpoint file."
+        );
+    }
 
-        for (auto const& comp : pc->getParticleRuntimeiComps()) {
-            auto search = std::find(int_comp_names.begin(), int_comp_names.end(), comp.first);
-            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-                search != int_comp_names.end(),
-                "Species " + species_names[i] + "needs runtime int component " + comp.first
-                + ", but it was not found in the checkpoint file."
+    for (int j = 0; j < ni; ++j) {
+        const auto& comp_name = int_comp_names[j];
+        auto current_comp_names = pc->getParticleiComps();
+        auto search = current_comp_names.find(comp_name);
+        if (search == current_comp_names.end()) {
+            amrex::Print()<< Utils::TextMsg::Info(
+                "Runtime int component " + comp_name
+                + " was found in the checkpoint file, but it has not been added yet. "
+                + " Adding it now."
             );
+            pc->AddIntComp(comp_name);
         }
+    }
 
-        for (int j = 0; j < ni; ++j) {
-            const auto& comp_name = int_comp_names[j];
-            auto current_comp_names = pc->getParticleiComps();
-            auto search = current_comp_names.find(comp_name);
-            if (search == current_comp_names.end()) {
-                amrex::Print()<< Utils::TextMsg::Info(
-                    "Runtime int component " + comp_name
-                    + " was found in the checkpoint file, but it has not been added yet. "
-                    + " Adding it now."
-                );
-                pc->AddIntComp(comp_name);
-            }
+    pc->Restart(dir, species_names.at(i));
+}
+
+void
+MultiParticleContainer::CheckDeferredRestart (int i) const
+{
+    const std::string& name = species_names[i];
+    const auto& pc = allcontainers.at(i);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        pc->do_not_push && pc->do_not_deposit && !pc->do_continuous_injection
+        && !pc->do_field_ionization && !pc->do_resampling && !pc->DoQED(),
+        name + ".restart_deferred = 1 requires a species that is not pushed (do_not_push = 1),"
+        " does not deposit (do_not_deposit = 1), and is not injected continuously, ionized,"
+        " resampled or involved in QED processes");
+
+    // the species must not receive particles from other species
+    const std::vector<std::string> product_keys = {
+        "ionization_product_species",
+        "qed_quantum_sync_phot_product_species",
+        "qed_breit_wheeler_ele_product_species",
+        "qed_breit_wheeler_pos_product_species"};
+    for (const auto& other : species_names) {
+        ParmParse pp_other(other);
+        for (const auto& key : product_keys) {
+            std::string product;
+            pp_other.query(key.c_str(), product);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(product != name,
+                name + ".restart_deferred = 1 cannot be used for the product species of "
+                + other + "." + key);
         }
+    }
+    ParmParse pp_qed_schwinger("qed_schwinger");
+    for (const std::string key : {"ele_product_species", "pos_product_species"}) {
+        std::string product;
+        pp_qed_schwinger.query(key.c_str(), product);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(product != name,
+            name + ".restart_deferred = 1 cannot be used for a product species of the Schwinger process");
+    }
 
-        pc->Restart(dir, species_names.at(i));
+    // ... nor be involved in collisions
+    ParmParse pp_collisions("collisions");
+    std::vector<std::string> collision_names;
+    pp_collisions.queryarr("collision_names", collision_names);
+    for (const auto& collision_name : collision_names) {
+        ParmParse pp_collision_name(collision_name);
+        std::vector<std::string> collision_species;
+        pp_collision_name.queryarr("species", collision_species);
+        std::vector<std::string> product_species;
+        pp_collision_name.queryarr("product_species", product_species);
+        collision_species.insert(collision_species.end(), product_species.begin(), product_species.end());
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            std::find(collision_species.begin(), collision_species.end(), name) == collision_species.end(),
+            name + ".restart_deferred = 1 cannot be used for a species involved in the collision "
+            + collision_name);
     }
-    for (unsigned i = species_names.size(); i < species_names.size()+lasers_names.size(); ++i) {
-        allcontainers.at(i)->Restart(dir, lasers_names.at(i-species_names.size()));
+}
+
+void
+MultiParticleContainer::LoadDeferredSpecies ()
+{
+    LoadDeferredSpecies(species_names);
+}
+
+void
+MultiParticleContainer::LoadDeferredSpecies (const std::vector<std::string>& species)
+{
+    if (m_deferred_restart.empty()) return;
+
+    WARPX_PROFILE("MultiParticleContainer::LoadDeferredSpecies()");
+
+    // the particle ids have advanced since the checkpoint was written:
+    // do not let the restart of the species reset them
+    const amrex::Long next_id = WarpXParticleContainer::ParticleType::UnprotectedNextID();
+
+    for (auto it = m_deferred_restart.begin(); it != m_deferred_restart.end(); ) {
+        const int i = it->first;
+        if (std::find(species.begin(), species.end(), species_names[i]) == species.end()) {
+            ++it;
+            continue;
+        }
+        amrex::Print() << Utils::TextMsg::Info(
+            "Reading the particles of species " + species_names[i] + " from checkpoint " + it->second);
+        RestartSpecies(i, it->second);
+        // the moving window and the load balancing may have changed the
+        // domain and the distribution of the grids since the restart
+        allcontainers[i]->Redistribute();
+        it = m_deferred_restart.erase(it);
     }
+
+    WarpXParticleContainer::ParticleType::NextID(
+        std::max(next_id, WarpXParticleContainer::ParticleType::UnprotectedNextID()));
 }
 
 void
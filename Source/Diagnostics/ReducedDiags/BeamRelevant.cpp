@@ -13,6 +13,8 @@
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
+#include <ablastr/particles/ParticleMoments.H>
+
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -189,68 +191,95 @@ void BeamRelevant::ComputeDiags (int step)
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        amrex::ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
-        ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_ops;
+        // variables of which the moments are computed:
+        // x, y, z, ux, uy, uz, gamma
+        auto const get_variables = [=] AMREX_GPU_DEVICE (const PType& p) noexcept
+        {
+            const ParticleReal p_ux = p.rdata(PIdx::ux);
+            const ParticleReal p_uy = p.rdata(PIdx::uy);
+            const ParticleReal p_uz = p.rdata(PIdx::uz);
+            const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
+            const ParticleReal p_gm = std::sqrt(1.0_rt+p_us*inv_c2);
+
+#if (defined WARPX_DIM_1D_Z)
+            const ParticleReal p_x = 0.0;
+            const ParticleReal p_y = 0.0;
+#elif (defined WARPX_DIM_RZ)
+            const ParticleReal p_pos0 = p.pos(0);
+            const ParticleReal p_theta = p.rdata(PIdx::theta);
+            const ParticleReal p_x = p_pos0*std::cos(p_theta);
+            const ParticleReal p_y = p_pos0*std::sin(p_theta);
+#elif (defined WARPX_DIM_XZ)
+            const ParticleReal p_x = p.pos(0);
+            const ParticleReal p_y = 0.0;
+#else
+            const ParticleReal p_x = p.pos(0);
+            const ParticleReal p_y = p.pos(1);
+#endif
+            const ParticleReal p_z = p.pos(index_z);
+
+            return amrex::GpuArray<ParticleReal,7>{p_x, p_y, p_z, p_ux, p_uy, p_uz, p_gm};
+        };
+
+        // The sums are computed relative to a particle of this rank, which
+        // avoids cancellations in the second moments of beams with a small
+        // spread compared to their mean position and momentum
+        auto const shift = ablastr::particles::FirstParticleValues<7>(myspc, get_variables);
+
+        // single pass over the particles: weight, first and second moments
+        amrex::ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
+        ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
+        ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_ops;
         auto r = amrex::ParticleReduce<amrex::ReduceData<ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal>>(
+        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
+        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
+        ParticleReal,ParticleReal,ParticleReal,ParticleReal>>(
             myspc,
             [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple
-            <ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-            ParticleReal,ParticleReal,ParticleReal>
+            <ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
+            ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
+            ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal>
             {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_pos0 = p.pos(0);
+                const auto v = get_variables(p);
                 const ParticleReal p_w = p.rdata(PIdx::w);
 
-#if (defined WARPX_DIM_RZ)
-                const ParticleReal p_theta = p.rdata(PIdx::theta);
-                const ParticleReal p_x_mean = p_pos0*std::cos(p_theta)*p_w;
-                const ParticleReal p_y_mean = p_pos0*std::sin(p_theta)*p_w;
-#else
-                const ParticleReal p_pos1 = p.pos(1);
-                const ParticleReal p_x_mean = p_pos0*p_w;
-                const ParticleReal p_y_mean = p_pos1*p_w;
-#endif
-                const ParticleReal p_z_mean = p.pos(index_z)*p_w;
-
-                const ParticleReal p_ux_mean = p_ux*p_w;
-                const ParticleReal p_uy_mean = p_uy*p_w;
-                const ParticleReal p_uz_mean = p_uz*p_w;
-                const ParticleReal p_gm_mean = std::sqrt(1.0_rt+p_us*inv_c2)*p_w;
+                const ParticleReal dx  = v[0] - shift[0];
+                const ParticleReal dy  = v[1] - shift[1];
+                const ParticleReal dz  = v[2] - shift[2];
+                const ParticleReal dux = v[3] - shift[3];
+                const ParticleReal duy = v[4] - shift[4];
+                const ParticleReal duz = v[5] - shift[5];
+                const ParticleReal dgm = v[6] - shift[6];
 
                 return {p_w,
-                        p_x_mean, p_y_mean, p_z_mean,
-                        p_ux_mean, p_uy_mean, p_uz_mean,
-                        p_gm_mean};
+                        dx*p_w, dy*p_w, dz*p_w,
+                        dux*p_w, duy*p_w, duz*p_w,
+                        dgm*p_w,
+                        dx*dx*p_w, dy*dy*p_w, dz*dz*p_w,
+                        dux*dux*p_w, duy*duy*p_w, duz*duz*p_w,
+                        dgm*dgm*p_w,
+                        dx*dux*p_w, dy*duy*p_w, dz*duz*p_w};
             },
             reduce_ops);
 
-        std::vector<ParticleReal> values_per_rank_1st = {
-            amrex::get<0>(r), // w
-            amrex::get<1>(r), // x_mean
-            amrex::get<2>(r), // y_mean
-            amrex::get<3>(r), // z_mean
-            amrex::get<4>(r), // ux_mean
-            amrex::get<5>(r), // uy_mean
-            amrex::get<6>(r), // uz_mean
-            amrex::get<7>(r), // gm_mean
-        };
+        const ParticleReal s1[7] = {
+            amrex::get<1>(r), amrex::get<2>(r), amrex::get<3>(r),
+            amrex::get<4>(r), amrex::get<5>(r), amrex::get<6>(r),
+            amrex::get<7>(r)};
+        const ParticleReal s2[10] = {
+            amrex::get<8>(r), amrex::get<9>(r), amrex::get<10>(r),
+            amrex::get<11>(r), amrex::get<12>(r), amrex::get<13>(r),
+            amrex::get<14>(r),
+            amrex::get<15>(r), amrex::get<16>(r), amrex::get<17>(r)};
 
-        // reduced sum over mpi ranks (allreduce)
-        amrex::ParallelAllReduce::Sum
-        ( values_per_rank_1st.data(), values_per_rank_1st.size(), ParallelDescriptor::Communicator());
+        // covariances of (x,ux), (y,uy) and (z,uz), for the emittances
+        ablastr::particles::WeightedMoments moments(7, {{0,3}, {1,4}, {2,5}});
+        moments.setFromShiftedSums(amrex::get<0>(r), shift.data(), s1, s2);
 
-        ParticleReal w_sum   = values_per_rank_1st.at(0);
-        ParticleReal x_mean  = values_per_rank_1st.at(1) /= w_sum;
-        ParticleReal y_mean  = values_per_rank_1st.at(2) /= w_sum;
-        ParticleReal z_mean  = values_per_rank_1st.at(3) /= w_sum;
-        ParticleReal ux_mean = values_per_rank_1st.at(4) /= w_sum;
-        ParticleReal uy_mean = values_per_rank_1st.at(5) /= w_sum;
-        ParticleReal uz_mean = values_per_rank_1st.at(6) /= w_sum;
-        ParticleReal gm_mean = values_per_rank_1st.at(7) /= w_sum;
+        // merge the moments of all mpi ranks (on the IO rank)
+        moments.ReduceToRoot(ParallelDescriptor::IOProcessorNumber());
+
+        ParticleReal w_sum   = moments.weight();
 
         if (w_sum < std::numeric_limits<Real>::min() )
         {
@@ -259,96 +288,25 @@ void BeamRelevant::ComputeDiags (int step)
             return;
         }
 
-        amrex::ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,
-        ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_ops2;
-
-        auto r2 = amrex::ParticleReduce<amrex::ReduceData<ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-        ParticleReal,ParticleReal,ParticleReal>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple
-            <ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal,
-            ParticleReal,ParticleReal,ParticleReal,ParticleReal,ParticleReal>
-            {
-                const ParticleReal p_ux = p.rdata(PIdx::ux);
-                const ParticleReal p_uy = p.rdata(PIdx::uy);
-                const ParticleReal p_uz = p.rdata(PIdx::uz);
-                const ParticleReal p_us = p_ux*p_ux + p_uy*p_uy + p_uz*p_uz;
-                const ParticleReal p_gm = std::sqrt(1.0_rt+p_us*inv_c2);
-                const ParticleReal p_w = p.rdata(PIdx::w);
-
-#if (defined WARPX_DIM_1D_Z)
-                const ParticleReal p_x = 0.0;
-                const ParticleReal p_y = 0.0;
-#elif (defined WARPX_DIM_RZ)
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_theta = p.rdata(PIdx::theta);
-                const ParticleReal p_x = p_pos0*std::cos(p_theta);
-                const ParticleReal p_y = p_pos0*std::sin(p_theta);
-#elif (defined WARPX_DIM_XZ)
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_x = p_pos0;
-                const ParticleReal p_y = 0.0;
-#else
-                const ParticleReal p_pos0 = p.pos(0);
-                const ParticleReal p_pos1 = p.pos(1);
-                const ParticleReal p_x = p_pos0;
-                const ParticleReal p_y = p_pos1;
-#endif
-                const ParticleReal p_z = p.pos(index_z);
-
-                const ParticleReal p_x_ms = (p_x-x_mean)*(p_x-x_mean)*p_w;
-                const ParticleReal p_y_ms = (p_y-y_mean)*(p_y-y_mean)*p_w;
-                const ParticleReal p_z_ms = (p_z-z_mean)*(p_z-z_mean)*p_w;
-
-                const ParticleReal p_ux_ms = (p_ux-ux_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_uy_ms = (p_uy-uy_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_uz_ms = (p_uz-uz_mean)*(p_uz-uz_mean)*p_w;
-                const ParticleReal p_gm_ms = (p_gm-gm_mean)*(p_gm-gm_mean)*p_w;
-
-                const ParticleReal p_xux = (p_x-x_mean)*(p_ux-ux_mean)*p_w;
-                const ParticleReal p_yuy = (p_y-y_mean)*(p_uy-uy_mean)*p_w;
-                const ParticleReal p_zuz = (p_z-z_mean)*(p_uz-uz_mean)*p_w;
-
-                const ParticleReal p_charge = q*p_w;
-
-                return {p_x_ms, p_y_ms, p_z_ms,
-                        p_ux_ms, p_uy_ms, p_uz_ms,
-                        p_gm_ms,
-                        p_xux, p_yuy, p_zuz,
-                        p_charge};
-            },
-            reduce_ops2);
-
-        std::vector<ParticleReal> values_per_rank_2nd = {
-            amrex::get<0>(r2), // x_ms
-            amrex::get<1>(r2), // y_ms
-            amrex::get<2>(r2), // z_ms
-            amrex::get<3>(r2), // ux_ms
-            amrex::get<4>(r2), // uy_ms
-            amrex::get<5>(r2), // uz_ms
-            amrex::get<6>(r2), // gm_ms
-            amrex::get<7>(r2), // xux
-            amrex::get<8>(r2), // yuy
-            amrex::get<9>(r2), // zuz
-            amrex::get<10>(r2) // charge
-        };
-
-        // reduced sum over mpi ranks (reduce to IO rank)
-        ParallelDescriptor::ReduceRealSum
-        ( values_per_rank_2nd.data(), values_per_rank_2nd.size(), ParallelDescriptor::IOProcessorNumber());
-
-        ParticleReal x_ms   = values_per_rank_2nd.at(0) /= w_sum;
-        ParticleReal y_ms   = values_per_rank_2nd.at(1) /= w_sum;
-        ParticleReal z_ms   = values_per_rank_2nd.at(2) /= w_sum;
-        ParticleReal ux_ms  = values_per_rank_2nd.at(3) /= w_sum;
-        ParticleReal uy_ms  = values_per_rank_2nd.at(4) /= w_sum;
-        ParticleReal uz_ms  = values_per_rank_2nd.at(5) /= w_sum;
-        ParticleReal gm_ms  = values_per_rank_2nd.at(6) /= w_sum;
-        ParticleReal xux    = values_per_rank_2nd.at(7) /= w_sum;
-        ParticleReal yuy    = values_per_rank_2nd.at(8) /= w_sum;
-        ParticleReal zuz    = values_per_rank_2nd.at(9) /= w_sum;
-        ParticleReal charge = values_per_rank_2nd.at(10);
+        ParticleReal x_mean  = moments.mean(0);
+        ParticleReal y_mean  = moments.mean(1);
+        ParticleReal z_mean  = moments.mean(2);
+        ParticleReal ux_mean = moments.mean(3);
+        ParticleReal uy_mean = moments.mean(4);
+        ParticleReal uz_mean = moments.mean(5);
+        ParticleReal gm_mean = moments.mean(6);
+
+        ParticleReal x_ms   = moments.variance(0);
+        ParticleReal y_ms   = moments.variance(1);
+        ParticleReal z_ms   = moments.variance(2);
+        ParticleReal ux_ms  = moments.variance(3);
+        ParticleReal uy_ms  = moments.variance(4);
+        ParticleReal uz_ms  = moments.variance(5);
+        ParticleReal gm_ms  = moments.variance(6);
+        ParticleReal xux    = moments.covariance(0);
+        ParticleReal yuy    = moments.covariance(1);
+        ParticleReal zuz    = moments.covariance(2);
+        ParticleReal charge = q*w_sum;
 
         // save data
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
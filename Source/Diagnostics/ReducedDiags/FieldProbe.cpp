@@ -14,6 +14,7 @@
 #include "Utils/IntervalsParser.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
@@ -21,6 +22,7 @@
 
 #include <AMReX_Array.H>
 #include <AMReX_Config.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -35,11 +37,17 @@
 #include <AMReX_StructOfArrays.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -153,6 +161,22 @@ FieldProbe::FieldProbe (std::string rd_name)
     pp_rd_name.query("raw_fields", raw_fields);
     pp_rd_name.query("interp_order", interp_order);
     pp_rd_name.query("do_moving_window_FP", do_moving_window_FP);
+    pp_rd_name.query("accumulate_steps", m_accumulate_steps);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_accumulate_steps > 0,
+                                     rd_name + ".accumulate_steps must be positive");
+    // the text and binary outputs gather the data of all accumulated steps on the
+    // I/O processor with a single Gatherv, whose lengths and displacements are int
+    const long npoints = (m_probe_geometry == DetectorGeometry::Point) ? 1l :
+        ((m_probe_geometry == DetectorGeometry::Line) ? long(m_resolution)
+                                                      : long(m_resolution) * long(m_resolution));
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_openpmd_output || long(m_accumulate_steps) * npoints * noutputs < long(INT_MAX),
+        rd_name + ".accumulate_steps * number of probe points * " + std::to_string(noutputs)
+        + " must be smaller than INT_MAX: reduce " + rd_name + ".accumulate_steps");
+#ifndef WARPX_USE_OPENPMD
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_openpmd_output,
+        rd_name + ".output_format = openpmd requires to compile with USE_OPENPMD=TRUE");
+#endif
 
     if (WarpX::gamma_boost > 1.0_rt)
     {
@@ -340,11 +364,45 @@ void FieldProbe::InitData ()
         amrex::Abort(Utils::TextMsg::Err(
             "Invalid probe geometry. Valid geometries are Point, Line, and Plane."));
     }
+
+    RedistributeProbes();
 }
 
 void FieldProbe::LoadBalance ()
+{
+    // This is called at every step: the static probes are only redistributed
+    // if the grids changed, or if the domain moved (moving window)
+    auto & warpx = WarpX::GetInstance();
+    const int nLevel = warpx.finestLevel() + 1;
+    bool changed = (nLevel != static_cast<int>(m_probe_grids.size()));
+    for (int lev = 0; lev < nLevel && !changed; ++lev)
+    {
+        changed = (m_probe_grids[lev] != warpx.boxArray(lev)) ||
+                  (m_probe_dmap[lev] != warpx.DistributionMap(lev));
+    }
+    const auto prob_lo = warpx.Geom(0).ProbLo();
+    for (int idim = 0; idim < AMREX_SPACEDIM && !changed; ++idim)
+    {
+        changed = (m_probe_domain_lo[idim] != prob_lo[idim]);
+    }
+    if (changed) { RedistributeProbes(); }
+}
+
+void FieldProbe::RedistributeProbes ()
 {
     m_probe.Redistribute();
+
+    auto & warpx = WarpX::GetInstance();
+    const int nLevel = warpx.finestLevel() + 1;
+    m_probe_grids.resize(nLevel);
+    m_probe_dmap.resize(nLevel);
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
+        m_probe_grids[lev] = warpx.boxArray(lev);
+        m_probe_dmap[lev] = warpx.DistributionMap(lev);
+    }
+    const auto prob_lo = warpx.Geom(0).ProbLo();
+    m_probe_domain_lo.assign(prob_lo, prob_lo + AMREX_SPACEDIM);
 }
 
 bool FieldProbe::ProbeInDomain () const
@@ -376,10 +434,12 @@ bool FieldProbe::ProbeInDomain () const
 
 void FieldProbe::ComputeDiags (int step)
 {
+    bool const is_output_step = m_intervals.contains(step+1);
+
     // Judge if the diags should be done
     if (!m_field_probe_integrate)
     {
-        if (!m_intervals.contains(step+1)) { return; }
+        if (!is_output_step) { return; }
     }
     // get a reference to WarpX instance
     auto & warpx = WarpX::GetInstance();
@@ -387,23 +447,81 @@ void FieldProbe::ComputeDiags (int step)
     // get number of mesh-refinement levels
     const auto nLevel = warpx.finestLevel() + 1;
 
+    using MyParIter = FieldProbeParticleContainer::iterator;
+
+    // Calculates particle movement in moving window sims
+    bool const update_particles_moving_window =
+        do_moving_window_FP &&
+        step > warpx.start_moving_window_step &&
+        step <= warpx.end_moving_window_step;
+    if (update_particles_moving_window)
+    {
+        for (int lev = 0; lev < nLevel; ++lev)
+        {
+            amrex::Real const dt = WarpX::GetInstance().getdt(lev);
+            int step_diff = step - m_last_compute_step;
+            amrex::Real const move_dist = dt*warpx.moving_window_v*step_diff;
+            for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
+            {
+                const auto getPosition = GetParticlePosition(pti);
+                auto setPosition = SetParticlePosition(pti);
+                auto const np = pti.numParticles();
+                const auto temp_warpx_moving_window = warpx.moving_window_dir;
+                amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
+                {
+                    amrex::ParticleReal xp, yp, zp;
+                    getPosition(ip, xp, yp, zp);
+                    if (temp_warpx_moving_window == 0)
+                    {
+                        setPosition(ip, xp+move_dist, yp, zp);
+                    }
+                    if (temp_warpx_moving_window == 1)
+                    {
+                        setPosition(ip, xp, yp+move_dist, zp);
+                    }
+                    if (temp_warpx_moving_window == WARPX_ZINDEX)
+                    {
+                        setPosition(ip, xp, yp, zp+move_dist);
+                    }
+                });
+            }
+        }
+        // the probes moved: this is the only case in which they are redistributed
+        // here (the static probes are only redistributed in LoadBalance if needed)
+        RedistributeProbes();
+    }
+
+    bool const probe_in_domain = ProbeInDomain();
+
+    // At output steps, the probe data is written in the accumulator by the gather
+    // kernel, after the data of the previous output steps that are not written yet
+    std::size_t acc_offset = m_accumulator.size();
+    if (is_output_step)
+    {
+        long numparticles = 0; // particles on this MPI rank
+        if (probe_in_domain)
+        {
+            for (int lev = 0; lev < nLevel; ++lev)
+            {
+                for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
+                {
+                    // count particle on MPI rank
+                    numparticles += pti.numParticles();
+                }
+            }
+        }
+        m_accumulated_steps.push_back(step);
+        m_accumulated_times.push_back(warpx.gett_new(0));
+        m_accumulated_points.push_back(numparticles);
+        m_accumulator.resize(acc_offset + numparticles * noutputs);
+    }
+
     // loop over refinement levels
     for (int lev = 0; lev < nLevel; ++lev)
     {
         const amrex::Geometry& gm = warpx.Geom(lev);
         const auto prob_lo = gm.ProbLo();
         amrex::Real const dt = WarpX::GetInstance().getdt(lev);
-        // Calculates particle movement in moving window sims
-        amrex::Real move_dist = 0.0;
-        bool const update_particles_moving_window =
-            do_moving_window_FP &&
-            step > warpx.start_moving_window_step &&
-            step <= warpx.end_moving_window_step;
-        if (update_particles_moving_window)
-        {
-            int step_diff = step - m_last_compute_step;
-            move_dist = dt*warpx.moving_window_v*step_diff;
-        }
 
         // get MultiFab data at lev
         const amrex::MultiFab &Ex = warpx.getEfield(lev, 0);
@@ -426,50 +544,12 @@ void FieldProbe::ComputeDiags (int step)
 
         // loop over each particle
         // TODO: add OMP parallel as in PhysicalParticleContainer::Evolve
-        long numparticles = 0; // particles on this MPI rank
-        using MyParIter = FieldProbeParticleContainer::iterator;
-        for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
-        {
-            // count particle on MPI rank
-            numparticles += pti.numParticles();
-        }
-
-        if (m_intervals.contains(step+1))
-        {
-            // reset m_data vector to clear pushed values. Reserves data
-            m_data.clear();
-            m_data.shrink_to_fit();
-            m_data.reserve(numparticles * noutputs);
-        }
-
         for (MyParIter pti(m_probe, lev); pti.isValid(); ++pti)
         {
             const auto getPosition = GetParticlePosition(pti);
-            auto setPosition = SetParticlePosition(pti);
 
             auto const np = pti.numParticles();
-            if (update_particles_moving_window)
-            {
-                const auto temp_warpx_moving_window = warpx.moving_window_dir;
-                amrex::ParallelFor( np, [=] AMREX_GPU_DEVICE (long ip)
-                {
-                    amrex::ParticleReal xp, yp, zp;
-                    getPosition(ip, xp, yp, zp);
-                    if (temp_warpx_moving_window == 0)
-                    {
-                        setPosition(ip, xp+move_dist, yp, zp);
-                    }
-                    if (temp_warpx_moving_window == 1)
-                    {
-                        setPosition(ip, xp, yp+move_dist, zp);
-                    }
-                    if (temp_warpx_moving_window == WARPX_ZINDEX)
-                    {
-                        setPosition(ip, xp, yp, zp+move_dist);
-                    }
-                });
-            }
-            if( ProbeInDomain() )
+            if( probe_in_domain )
             {
                 const auto cell_size = gm.CellSizeArray();
                 const int i_probe = static_cast<int>(amrex::Math::floor((x_probe - prob_lo[0]) / cell_size[0]));
@@ -507,6 +587,12 @@ void FieldProbe::ComputeDiags (int step)
                 ParticleReal* const AMREX_RESTRICT part_Bz = attribs[FieldProbePIdx::Bz].dataPtr();
                 ParticleReal* const AMREX_RESTRICT part_S = attribs[FieldProbePIdx::S].dataPtr();
 
+                // output rows of the particles of this tile in the accumulator (at output steps)
+                ParticleReal* const AMREX_RESTRICT acc =
+                    is_output_step ? m_accumulator.dataPtr() + acc_offset : nullptr;
+                acc_offset += is_output_step ? np * noutputs : 0;
+                constexpr int nout = noutputs;
+
                 const auto &xyzmin = WarpX::LowerCorner(box, lev, 0._rt);
                 const std::array<Real, 3> &dx = WarpX::CellSize(lev);
 
@@ -579,108 +665,243 @@ void FieldProbe::ComputeDiags (int step)
                         part_Bz[ip] = Bzp; //remember to add lorentz transform
                         part_S[ip] = S; //remember to add lorentz transform
                     }
-                });// ParallelFor Close
-                // this check is here because for m_field_probe_integrate == True, we always compute
-                // but we only write when we truly are in an output interval step
-                if (m_intervals.contains(step+1))
-                {
-                    for (auto ip=0; ip < np; ip++)
+
+                    // for m_field_probe_integrate == True, we always compute
+                    // but we only output when we truly are in an output interval step
+                    if (acc)
                     {
-                        amrex::ParticleReal xp, yp, zp;
-                        getPosition(ip, xp, yp, zp);
-
-                        // push to output vector
-                        m_data.push_back(xp);
-                        m_data.push_back(yp);
-                        m_data.push_back(zp);
-                        m_data.push_back(part_Ex[ip]);
-                        m_data.push_back(part_Ey[ip]);
-                        m_data.push_back(part_Ez[ip]);
-                        m_data.push_back(part_Bx[ip]);
-                        m_data.push_back(part_By[ip]);
-                        m_data.push_back(part_Bz[ip]);
-                        m_data.push_back(part_S[ip]);
+                        /* the row contains up-to-date values for:
+                         *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
+                        ParticleReal* const row = acc + ip * nout;
+                        row[0] = xp;
+                        row[1] = yp;
+                        row[2] = zp;
+                        row[3] = part_Ex[ip];
+                        row[4] = part_Ey[ip];
+                        row[5] = part_Ez[ip];
+                        row[6] = part_Bx[ip];
+                        row[7] = part_By[ip];
+                        row[8] = part_Bz[ip];
+                        row[9] = part_S[ip];
                     }
-                /* m_data now contains up-to-date values for:
-                 *  [x, y, z, Ex, Ey, Ez, Bx, By, Bz, and S] */
-                }
+                });// ParallelFor Close
             }
         } // end particle iterator loop
-        Gpu::synchronize();
-        if (m_intervals.contains(step+1))
+    }// end loop over refinement levels
+    Gpu::synchronize();
+
+    // the data of m_accumulate_steps output steps is written at once
+    if (static_cast<int>(m_accumulated_steps.size()) >= m_accumulate_steps)
+    {
+        FlushDistributedData();
+    }
+    m_last_compute_step = step;
+} // end void FieldProbe::ComputeDiags
+
+void FieldProbe::FlushDistributedData ()
+{
+    if (m_accumulated_steps.empty()) { return; }
+
+    WARPX_PROFILE("FieldProbe::FlushDistributedData()");
+
+    // a single copy from the device for all the accumulated output steps
+    amrex::Vector<amrex::ParticleReal> data(m_accumulator.size());
+    amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost,
+                          m_accumulator.begin(), m_accumulator.end(), data.begin());
+    amrex::Gpu::streamSynchronize();
+
+#ifdef WARPX_USE_OPENPMD
+    if (m_openpmd_output)
+    {
+        WriteOpenPMD(data);
+    }
+    else
+#endif
+    {
+        WriteRows(data);
+    }
+
+    m_accumulator.clear();
+    m_accumulated_steps.clear();
+    m_accumulated_times.clear();
+    m_accumulated_points.clear();
+}
+
+void FieldProbe::WriteRows (amrex::Vector<amrex::ParticleReal> const& data) const
+{
+    int const nsteps = static_cast<int>(m_accumulated_steps.size());
+    int const mpisize = ParallelDescriptor::NProcs();
+    int const ioproc = ParallelDescriptor::IOProcessorNumber();
+
+    // number of values of each accumulated step, from each MPI rank
+    amrex::Vector<int> local_lengths(nsteps);
+    for (int is = 0; is < nsteps; ++is)
+    {
+        local_lengths[is] = static_cast<int>(m_accumulated_points[is] * noutputs);
+    }
+    amrex::Vector<int> lengths;
+    if (ParallelDescriptor::IOProcessor()) { lengths.resize(mpisize * nsteps, 0); }
+    ParallelDescriptor::Gather(local_lengths.data(), nsteps, lengths.data(), nsteps, ioproc);
+
+    /* displs records the size of the data from each MPI rank as well as previous displs.
+     * This array tells Gatherv where in the data_out array to write incoming data. */
+    amrex::Vector<int> length_vector;
+    amrex::Vector<int> displs_vector;
+    amrex::Vector<amrex::ParticleReal> data_out;
+    if (ParallelDescriptor::IOProcessor())
+    {
+        length_vector.resize(mpisize, 0);
+        displs_vector.resize(mpisize, 0);
+        long total_data_size = 0;
+        for (int i = 0; i < mpisize; ++i)
         {
-            // returns total number of mpi notes into mpisize
-            int mpisize = ParallelDescriptor::NProcs();
+            for (int is = 0; is < nsteps; ++is) { length_vector[i] += lengths[i * nsteps + is]; }
+            if (i > 0) { displs_vector[i] = displs_vector[i-1] + length_vector[i-1]; }
+            total_data_size += length_vector[i];
+        }
+        data_out.resize(total_data_size, 0);
+    }
+    // a single Gatherv for all the accumulated steps
+    ParallelDescriptor::Gatherv(data.data(), static_cast<int>(data.size()),
+                                data_out.data(), length_vector, displs_vector, ioproc);
 
-            // allocates data space for length_array. Will contain size of m_data from each processor
-            amrex::Vector<int> length_vector;
-            amrex::Vector<int> localsize;
+    if (!ParallelDescriptor::IOProcessor()) { return; }
 
-            if (amrex::ParallelDescriptor::IOProcessor()) {
-                length_vector.resize(mpisize, 0);
-            }
-            localsize.resize(1, m_data.size());
-
-            // gather size of m_data from each processor
-            amrex::ParallelDescriptor::Gather(localsize.data(), 1,
-                                              length_vector.data(), 1,
-                                              amrex::ParallelDescriptor::IOProcessorNumber());
-
-            // IO processor sums values from length_array to get size of total output array.
-            /* displs records the size of each m_data as well as previous displs. This array
-             * tells Gatherv where in the m_data_out array allocation to write incomming data. */
-            long total_data_size = 0;
-            amrex::Vector<int> displs_vector;
-            if (amrex::ParallelDescriptor::IOProcessor()) {
-                displs_vector.resize(mpisize, 0);
-                displs_vector[0] = 0;
-                total_data_size += length_vector[0];
-                for (int i=1; i<mpisize; i++) {
-                    displs_vector[i] = (displs_vector[i-1] + length_vector[i-1]);
-                    total_data_size += length_vector[i];
+    // rows of each step, ordered by MPI rank
+    amrex::Vector<int> read_offset(displs_vector.begin(), displs_vector.end());
+    for (int is = 0; is < nsteps; ++is)
+    {
+        const int step = m_accumulated_steps[is];
+        const amrex::Real time = m_accumulated_times[is];
+        for (int i = 0; i < mpisize; ++i)
+        {
+            const int length = lengths[i * nsteps + is];
+            for (int ip = 0; ip < length / noutputs; ++ip)
+            {
+                const amrex::ParticleReal* const values = data_out.data() + read_offset[i] + ip * noutputs;
+                if (m_binary_output)
+                {
+                    std::vector<double> row = {static_cast<double>(step + 1), time};
+                    row.insert(row.end(), values, values + noutputs);
+                    BufferBinaryRow(row);
+                    continue;
+                }
+                std::ostringstream ofs;
+                ofs << std::fixed << std::defaultfloat;
+                ofs << step + 1;
+                ofs << m_sep;
+                ofs << std::fixed << std::setprecision(14) << std::scientific;
+                // write time
+                ofs << time;
+
+                for (int k = 0; k < noutputs; k++)
+                {
+                    ofs << m_sep;
+                    ofs << values[k];
                 }
-                // valid particles are counted (for all MPI ranks) to inform output processes as to size of output
-                m_valid_particles = total_data_size / noutputs;
-                m_data_out.resize(total_data_size, 0);
+                ofs << '\n';
+                BufferTextRow(ofs.str());
             }
-            // resize receive buffer (resize, initialize 0)
-            // gather m_data of varied lengths from all processors. Prints to m_data_out
-            amrex::ParallelDescriptor::Gatherv(m_data.data(), localsize[0],
-                                               m_data_out.data(), length_vector, displs_vector,
-                                               amrex::ParallelDescriptor::IOProcessorNumber());
+            read_offset[i] += length;
         }
-    }// end loop over refinement levels
-    // make sure data is in m_data on the IOProcessor
-    // TODO: In the future, we want to use a parallel I/O method instead (plotfiles or openPMD)
-    m_last_compute_step = step;
-} // end void FieldProbe::ComputeDiags
+    }
+}
 
-void FieldProbe::WriteToFile (int step) const
+#ifdef WARPX_USE_OPENPMD
+void FieldProbe::WriteOpenPMD (amrex::Vector<amrex::ParticleReal> const& data)
 {
-    if (ProbeInDomain() && amrex::ParallelDescriptor::IOProcessor())
+    if (!m_openpmd_series)
     {
-        // open file
-        std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-                          std::ofstream::out | std::ofstream::app};
+        // one file (group-based encoding) for all the steps
+        std::string filetype = "h5";
+#if openPMD_HAVE_ADIOS2==1 || openPMD_HAVE_ADIOS1==1
+        filetype = "bp";
+#endif
+        const std::string filepath = m_path + m_rd_name + "." + filetype;
+        const openPMD::Access access = m_IsNotRestart ?
+            openPMD::Access::CREATE : openPMD::Access::APPEND;
+#if defined(AMREX_USE_MPI)
+        m_openpmd_series = std::make_unique<openPMD::Series>(
+            filepath, access, ParallelDescriptor::Communicator());
+#else
+        m_openpmd_series = std::make_unique<openPMD::Series>(filepath, access);
+#endif
+        m_openpmd_series->setIterationEncoding(openPMD::IterationEncoding::groupBased);
+        m_openpmd_series->setSoftware("WarpX", WarpX::Version());
+    }
 
-        // loop over num valid particles and write
-        for (int i = 0; i < m_valid_particles; i++)
-        {
-            ofs << std::fixed << std::defaultfloat;
-            ofs << step + 1;
-            ofs << m_sep;
-            ofs << std::fixed << std::setprecision(14) << std::scientific;
-            // write time
-            ofs << WarpX::GetInstance().gett_new(0);
+    int const nsteps = static_cast<int>(m_accumulated_steps.size());
+
+    // offset of the probe points of this MPI rank, and total number of probe points, of each step
+    std::vector<unsigned long long> np(nsteps);
+    for (int is = 0; is < nsteps; ++is) { np[is] = m_accumulated_points[is]; }
+    std::vector<unsigned long long> offset(nsteps, 0);
+    std::vector<unsigned long long> total(np);
+#if defined(AMREX_USE_MPI)
+    MPI_Comm const comm = ParallelDescriptor::Communicator();
+    MPI_Exscan(np.data(), offset.data(), nsteps, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    if (ParallelDescriptor::MyProc() == 0) { std::fill(offset.begin(), offset.end(), 0); }
+    MPI_Allreduce(np.data(), total.data(), nsteps, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+#endif
+
+    // units of the fields, multiplied by a time for the integrated fields
+    const double time_power = m_field_probe_integrate ? 1. : 0.;
+    using UD = openPMD::UnitDimension;
+    const std::map<UD, double> unit_E = {{UD::L, 1.}, {UD::M, 1.}, {UD::T, -3. + time_power}, {UD::I, -1.}};
+    const std::map<UD, double> unit_B = {{UD::M, 1.}, {UD::T, -2. + time_power}, {UD::I, -1.}};
+    const std::map<UD, double> unit_S = {{UD::M, 1.}, {UD::T, -3. + time_power}};
+
+    std::size_t data_offset = 0;
+    for (int is = 0; is < nsteps; ++is)
+    {
+        auto iteration = m_openpmd_series->iterations[m_accumulated_steps[is] + 1];
+        iteration.setTime(m_accumulated_times[is]);
+        auto probe = iteration.particles["probe"];
 
-            for (int k = 0; k < noutputs; k++)
+        const openPMD::Dataset dataset{
+            openPMD::determineDatatype<amrex::ParticleReal>(), {total[is]}};
+
+        // component k of the rows of this MPI rank
+        const auto StoreComponent = [&] (openPMD::RecordComponent rc, int k)
+        {
+            rc.resetDataset(dataset);
+            if (np[is] == 0) { return; }
+            std::shared_ptr<amrex::ParticleReal> values{
+                new amrex::ParticleReal[np[is]], std::default_delete<amrex::ParticleReal[]>()};
+            for (unsigned long long ip = 0; ip < np[is]; ++ip)
             {
-                ofs << m_sep;
-                ofs << m_data_out[i * noutputs + k];
+                values.get()[ip] = data[data_offset + ip * noutputs + k];
             }
-            ofs << std::endl;
-        } // end loop over data size
-    // close file
-    ofs.close();
+            rc.storeChunk(values, {offset[is]}, {np[is]});
+        };
+
+        const std::vector<std::string> xyz = {"x", "y", "z"};
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            StoreComponent(probe["position"][xyz[idim]], idim);
+            auto position_offset = probe["positionOffset"][xyz[idim]];
+            position_offset.resetDataset(dataset);
+            position_offset.makeConstant(amrex::ParticleReal(0));
+            StoreComponent(probe["E"][xyz[idim]], 3 + idim);
+            StoreComponent(probe["B"][xyz[idim]], 6 + idim);
+        }
+        StoreComponent(probe["S"][openPMD::RecordComponent::SCALAR], 9);
+
+        probe["position"].setUnitDimension({{UD::L, 1.}});
+        probe["positionOffset"].setUnitDimension({{UD::L, 1.}});
+        probe["E"].setUnitDimension(unit_E);
+        probe["B"].setUnitDimension(unit_B);
+        probe["S"].setUnitDimension(unit_S);
+
+        // collective: writes the chunks of all MPI ranks
+        iteration.close();
+
+        data_offset += np[is] * noutputs;
     }
 }
+#endif
+
+void FieldProbe::WriteToFile (int /*step*/) const
+{
+    // the probe data is written by FlushDistributedData, on all MPI ranks
+}
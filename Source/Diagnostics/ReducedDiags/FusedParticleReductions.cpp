@@ -0,0 +1,158 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "FusedParticleReductions.H"
+
+#include "Particles/Algorithms/KineticEnergy.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/SpeciesPhysicalProperties.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleReduce.H>
+#include <AMReX_Particles.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+void FusedParticleReductions::Compute (int step)
+{
+    WARPX_PROFILE("FusedParticleReductions::Compute()");
+
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    const int nSpecies = mypc.nSpecies();
+
+    m_sums.assign(nSpecies*nquantities, 0.0_rt);
+    m_min.assign(nSpecies*nextrema, 0.0_rt);
+    m_max.assign(nSpecies*nextrema, 0.0_rt);
+    m_num_particles.assign(nSpecies, 0);
+
+    // inverse of speed of light squared
+    Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
+
+    using PType = typename WarpXParticleContainer::SuperParticleType;
+
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        const auto & myspc = mypc.GetParticleContainer(i_s);
+
+        const bool is_photon = myspc.AmIA<PhysicalSpecies::photon>();
+        // Mass used for the energy (unused for photons)
+        const amrex::Real m = myspc.getMass();
+        // Mass used for the momentum: for photons, ux, uy, uz are
+        // calculated assuming a mass equal to the electron mass
+        const amrex::Real m_mom = is_photon ? PhysConst::m_e : m;
+        // gamma = sqrt(gamma_offset + u^2/c^2), i.e. |u|/c for photons
+        const amrex::Real gamma_offset = is_photon ? 0.0_rt : 1.0_rt;
+
+        // One loop over the particles held by this MPI rank for all the quantities:
+        // the sums, then the minima, then the maxima
+        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpSum, ReduceOpSum, ReduceOpSum,
+                         ReduceOpMin, ReduceOpMin, ReduceOpMin, ReduceOpMin,
+                         ReduceOpMin, ReduceOpMin, ReduceOpMin, ReduceOpMin,
+                         ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax,
+                         ReduceOpMax, ReduceOpMax, ReduceOpMax, ReduceOpMax> reduce_ops;
+        using ReduceTuple = amrex::GpuTuple<Real, Real, Real, Real, Real, Long,
+                                            Real, Real, Real, Real, Real, Real, Real, Real,
+                                            Real, Real, Real, Real, Real, Real, Real, Real>;
+        auto r = amrex::ParticleReduce<
+            amrex::ReduceData<Real, Real, Real, Real, Real, Long,
+                              Real, Real, Real, Real, Real, Real, Real, Real,
+                              Real, Real, Real, Real, Real, Real, Real, Real>>(
+            myspc,
+            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> ReduceTuple
+            {
+#if (defined WARPX_DIM_RZ)
+                const amrex::Real xp = p.pos(0)*std::cos(p.rdata(PIdx::theta));
+                const amrex::Real yp = p.pos(0)*std::sin(p.rdata(PIdx::theta));
+                const amrex::Real zp = p.pos(1);
+#elif (defined WARPX_DIM_XZ)
+                const amrex::Real xp = p.pos(0);
+                const amrex::Real yp = 0.0_rt;
+                const amrex::Real zp = p.pos(1);
+#elif (defined WARPX_DIM_1D_Z)
+                const amrex::Real xp = 0.0_rt;
+                const amrex::Real yp = 0.0_rt;
+                const amrex::Real zp = p.pos(0);
+#else
+                const amrex::Real xp = p.pos(0);
+                const amrex::Real yp = p.pos(1);
+                const amrex::Real zp = p.pos(2);
+#endif
+                const amrex::Real w  = p.rdata(PIdx::w);
+                const amrex::Real ux = p.rdata(PIdx::ux);
+                const amrex::Real uy = p.rdata(PIdx::uy);
+                const amrex::Real uz = p.rdata(PIdx::uz);
+                const amrex::Real E = is_photon ?
+                    Algorithms::KineticEnergyPhotons(ux,uy,uz) :
+                    Algorithms::KineticEnergy(ux,uy,uz,m);
+                const amrex::Real g = std::sqrt(gamma_offset + (ux*ux + uy*uy + uz*uz)*inv_c2);
+                const Long valid = (p.id() > 0) ? 1 : 0;
+                return {w, w*E, w*m_mom*ux, w*m_mom*uy, w*m_mom*uz, valid,
+                        xp, yp, zp, ux, uy, uz, g, w,
+                        xp, yp, zp, ux, uy, uz, g, w};
+            },
+            reduce_ops);
+
+        m_sums[i_s*nquantities + weight] = amrex::get<0>(r);
+        m_sums[i_s*nquantities + energy] = amrex::get<1>(r);
+        m_sums[i_s*nquantities + px]     = amrex::get<2>(r);
+        m_sums[i_s*nquantities + py]     = amrex::get<3>(r);
+        m_sums[i_s*nquantities + pz]     = amrex::get<4>(r);
+        m_num_particles[i_s] = amrex::get<5>(r);
+
+        Real* const mins = m_min.data() + i_s*nextrema;
+        mins[ext_x]     = amrex::get<6>(r);
+        mins[ext_y]     = amrex::get<7>(r);
+        mins[ext_z]     = amrex::get<8>(r);
+        mins[ext_ux]    = amrex::get<9>(r);
+        mins[ext_uy]    = amrex::get<10>(r);
+        mins[ext_uz]    = amrex::get<11>(r);
+        mins[ext_gamma] = amrex::get<12>(r);
+        mins[ext_w]     = amrex::get<13>(r);
+
+        Real* const maxs = m_max.data() + i_s*nextrema;
+        maxs[ext_x]     = amrex::get<14>(r);
+        maxs[ext_y]     = amrex::get<15>(r);
+        maxs[ext_z]     = amrex::get<16>(r);
+        maxs[ext_ux]    = amrex::get<17>(r);
+        maxs[ext_uy]    = amrex::get<18>(r);
+        maxs[ext_uz]    = amrex::get<19>(r);
+        maxs[ext_gamma] = amrex::get<20>(r);
+        maxs[ext_w]     = amrex::get<21>(r);
+    }
+
+    // One reduction over MPI ranks per operation for all species
+    const int io_proc = ParallelDescriptor::IOProcessorNumber();
+    ParallelDescriptor::ReduceRealSum(m_sums.data(), static_cast<int>(m_sums.size()), io_proc);
+    ParallelDescriptor::ReduceLongSum(m_num_particles.data(),
+                                      static_cast<int>(m_num_particles.size()), io_proc);
+    ParallelDescriptor::ReduceRealMin(m_min.data(), static_cast<int>(m_min.size()), io_proc);
+    ParallelDescriptor::ReduceRealMax(m_max.data(), static_cast<int>(m_max.size()), io_proc);
+
+#if (defined WARPX_DIM_XZ || defined WARPX_DIM_1D_Z)
+    // The coordinates that are not in the geometry are 0, also for species without particles
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        m_min[i_s*nextrema + ext_y] = m_max[i_s*nextrema + ext_y] = 0.0_rt;
+#   if (defined WARPX_DIM_1D_Z)
+        m_min[i_s*nextrema + ext_x] = m_max[i_s*nextrema + ext_x] = 0.0_rt;
+#   endif
+    }
+#endif
+
+    m_step = step;
+}
@@ -32,6 +32,7 @@
 #include <iomanip>
 #include <istream>
 #include <memory>
+#include <sstream>
 #include <utility>
 
 using namespace amrex;
@@ -245,39 +246,44 @@ void LoadBalanceCosts::ComputeDiags (int step)
 // write to file function for cost
 void LoadBalanceCosts::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-            std::ofstream::out | std::ofstream::app};
+    if (m_binary_output)
+    {
+        // the hostnames are not written in binary format
+        ReducedDiags::WriteToFile(step);
+    }
+    else
+    {
+        std::ostringstream ofs;
 
-    // write step
-    ofs << step+1 << m_sep;
+        // write step
+        ofs << step+1 << m_sep;
 
-    // set precision
-    ofs << std::fixed << std::setprecision(14) << std::scientific;
+        // set precision
+        ofs << std::fixed << std::setprecision(14) << std::scientific;
 
-    // write time
-    ofs << WarpX::GetInstance().gett_new(0);
+        // write time
+        ofs << WarpX::GetInstance().gett_new(0);
 
-    // loop over data size and write
-    for (int i = 0; i < static_cast<int>(m_data.size()); ++i)
-    {
-        ofs << m_sep << m_data[i];
-        if ((i - m_nDataFields + 1)%m_nDataFields == 0)
+        // loop over data size and write
+        for (int i = 0; i < static_cast<int>(m_data.size()); ++i)
         {
-            // at the end of current group of m_nDatafields, output the string data (hostname)
-            int ind_rank = i - m_nDataFields + 2; // index for the rank corresponding to current box
+            ofs << m_sep << m_data[i];
+            if ((i - m_nDataFields + 1)%m_nDataFields == 0)
+            {
+                // at the end of current group of m_nDatafields, output the string data (hostname)
+                int ind_rank = i - m_nDataFields + 2; // index for the rank corresponding to current box
 
-            // m_data --> rank --> hostname
-            ofs << m_sep << m_data_string[static_cast<long unsigned int>(m_data[ind_rank])];
+                // m_data --> rank --> hostname
+                ofs << m_sep << m_data_string[static_cast<long unsigned int>(m_data[ind_rank])];
+            }
         }
-    }
-    // end loop over data size
+        // end loop over data size
 
-    // end line
-    ofs << std::endl;
+        // end line
+        ofs << '\n';
 
-    // close file
-    ofs.close();
+        BufferTextRow(ofs.str());
+    }
 
     // get a reference to WarpX instance
     auto& warpx = WarpX::GetInstance();
@@ -287,6 +293,9 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // final step is a special case, fill jagged array with NaN
     if (m_intervals.nextContains(step+1) > warpx.maxStep())
     {
+        // all the rows must be in the file
+        FlushBuffer();
+
         // open tmp file to copy data
         std::string fileTmpName = m_path + m_rd_name + ".tmp." + m_extension;
         std::ofstream ofstmp(fileTmpName, std::ofstream::out);
@@ -295,7 +304,8 @@ void LoadBalanceCosts::WriteToFile (int step) const
         // for each box on each level we saved 9(10) data fields:
         //   [cost, proc, lev, i_low, j_low, k_low, num_cells, num_macro_particles(, gpu_ID_box), hostname]
         // nDataFieldsToWrite = below accounts for the Real data fields (m_nDataFields), then 1 string output to write
-        int nDataFieldsToWrite = m_nDataFields + 1;
+        // (the hostnames are not written in binary format, so they are not in the header either)
+        int nDataFieldsToWrite = m_nDataFields + (m_binary_output ? 0 : 1);
 
         int c = 0;
         ofstmp << "#";
@@ -325,13 +335,24 @@ void LoadBalanceCosts::WriteToFile (int step) const
             ofstmp << m_sep;
             ofstmp << "[" << c++ << "]gpu_ID_box_" + std::to_string(boxNumber) + "()";
 #endif
-            ofstmp << m_sep;
-            ofstmp << "[" << c++ << "]hostname_box_" + std::to_string(boxNumber) + "()";
+            if (!m_binary_output) {
+                ofstmp << m_sep;
+                ofstmp << "[" << c++ << "]hostname_box_" + std::to_string(boxNumber) + "()";
+            }
         }
         ofstmp << std::endl;
 
-        // open the data-containing file
+        // in binary format, the text file only contains the header: the rows
+        // in the binary file are not padded, since each one stores its length
         std::string fileDataName = m_path + m_rd_name + "." + m_extension;
+        if (m_binary_output) {
+            ofstmp.close();
+            std::remove(fileDataName.c_str());
+            std::rename(fileTmpName.c_str(), fileDataName.c_str());
+            return;
+        }
+
+        // open the data-containing file
         std::ifstream ifs(fileDataName, std::ifstream::in);
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ifs, "Failed to load balance file");
         ifs.exceptions(std::ios_base::badbit); // | std::ios_base::failbit
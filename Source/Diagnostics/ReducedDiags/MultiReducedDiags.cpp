@@ -19,10 +19,13 @@
 #include "ParticleHistogram.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "PoissonSolverConvergence.H"
 #include "RhoMaximum.H"
+#include "Particles/MultiParticleContainer.H"
 #include "Utils/IntervalsParser.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
 
 #include <AMReX.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -62,7 +65,8 @@ MultiReducedDiags::MultiReducedDiags ()
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
-            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}}
+            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
+            {"PoissonSolverConvergence", [](CS s){return std::make_unique<PoissonSolverConvergence>(s);}}
         };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
     std::transform(m_rd_names.begin(), m_rd_names.end(), std::back_inserter(m_multi_rd),
@@ -81,6 +85,12 @@ MultiReducedDiags::MultiReducedDiags ()
             return reduced_diags_dictionary.at(rd_type)(rd_name);
         });
     // end loop over all reduced diags
+
+    for (auto& rd : m_multi_rd) {
+        if (rd->UsesFusedParticleSums()) { rd->m_fused_particle_sums = &m_fused_particle_sums; }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!rd->m_openpmd_output || rd->SupportsOpenPMDOutput(),
+            rd->m_rd_name + ".output_format = openpmd is not supported by this type of reduced diagnostic");
+    }
 }
 // end constructor
 
@@ -106,6 +116,18 @@ void MultiReducedDiags::ComputeDiags (int step)
 {
     WARPX_PROFILE("MultiReducedDiags::ComputeDiags()");
 
+    // compute the particle sums shared by the reduced diagnostics done at this step
+    const bool compute_fused_particle_sums = std::any_of(m_multi_rd.begin(), m_multi_rd.end(),
+        [step](const auto& rd){
+            return rd->UsesFusedParticleSums() && rd->m_intervals.contains(step+1);
+        });
+    // the species whose restart was deferred are read when first needed
+    const bool compute_any = std::any_of(m_multi_rd.begin(), m_multi_rd.end(),
+        [step](const auto& rd){ return rd->m_intervals.contains(step+1); });
+    if (compute_any) { WarpX::GetInstance().GetPartContainer().LoadDeferredSpecies(); }
+
+    if (compute_fused_particle_sums) { m_fused_particle_sums.Compute(step); }
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
@@ -133,3 +155,14 @@ void MultiReducedDiags::WriteToFile (int step)
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+void MultiReducedDiags::FlushBuffers ()
+{
+    // data accumulated on all MPI ranks (this may add rows on the I/O rank)
+    for (auto& rd : m_multi_rd) { rd->FlushDistributedData(); }
+
+    // Only the I/O rank has rows in memory
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    for (auto& rd : m_multi_rd) { rd->FlushBuffer(); }
+}
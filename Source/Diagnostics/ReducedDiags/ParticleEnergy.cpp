@@ -7,6 +7,7 @@
 
 #include "ParticleEnergy.H"
 
+#include "Diagnostics/ReducedDiags/FusedParticleReductions.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/Algorithms/KineticEnergy.H"
 #include "Particles/MultiParticleContainer.H"
@@ -119,49 +120,58 @@ void ParticleEnergy::ComputeDiags (int step)
         amrex::Real Etot = 0.0_rt;
         amrex::Real Ws   = 0.0_rt;
 
-        // Use amrex::ParticleReduce to compute the sum of energies and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Etot, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
-        if(myspc.AmIA<PhysicalSpecies::photon>())
+        if (m_fused_particle_sums && m_fused_particle_sums->isComputed(step))
         {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    return {w*Algorithms::KineticEnergyPhotons(ux,uy,uz),w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
+            // Sums already computed (and reduced over MPI ranks) for all particle diagnostics
+            Etot = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::energy);
+            Ws   = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::weight);
         }
-        else // particle other than photons
+        else
         {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-
-                    return {w*Algorithms::KineticEnergy(ux,uy,uz,m), w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
+            // Use amrex::ParticleReduce to compute the sum of energies and weights of all particles
+            // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
+            // the result r is the tuple (Etot, Ws)
+            amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
+            if(myspc.AmIA<PhysicalSpecies::photon>())
+            {
+                auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
+                    myspc,
+                    [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
+                    {
+                        const amrex::Real w  = p.rdata(PIdx::w);
+                        const amrex::Real ux = p.rdata(PIdx::ux);
+                        const amrex::Real uy = p.rdata(PIdx::uy);
+                        const amrex::Real uz = p.rdata(PIdx::uz);
+                        return {w*Algorithms::KineticEnergyPhotons(ux,uy,uz),w};
+                    },
+                    reduce_ops);
+
+                Etot = amrex::get<0>(r);
+                Ws   = amrex::get<1>(r);
+            }
+            else // particle other than photons
+            {
+                auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
+                    myspc,
+                    [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
+                    {
+                        const amrex::Real w  = p.rdata(PIdx::w);
+                        const amrex::Real ux = p.rdata(PIdx::ux);
+                        const amrex::Real uy = p.rdata(PIdx::uy);
+                        const amrex::Real uz = p.rdata(PIdx::uz);
+
+                        return {w*Algorithms::KineticEnergy(ux,uy,uz,m), w};
+                    },
+                    reduce_ops);
+
+                Etot = amrex::get<0>(r);
+                Ws   = amrex::get<1>(r);
+            }
 
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Etot, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws  , ParallelDescriptor::IOProcessorNumber());
+            // Reduced sum over MPI ranks
+            ParallelDescriptor::ReduceRealSum(Etot, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealSum(Ws  , ParallelDescriptor::IOProcessorNumber());
+        }
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
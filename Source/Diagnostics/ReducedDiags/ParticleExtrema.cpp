@@ -7,6 +7,7 @@
 
 #include "ParticleExtrema.H"
 
+#include "Diagnostics/ReducedDiags/FusedParticleReductions.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #if (defined WARPX_QED)
 #   include "Particles/ElementaryProcess/QEDInternals/QedChiFunctions.H"
@@ -193,175 +194,204 @@ void ParticleExtrema::ComputeDiags (int step)
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        // xmin
+        Real xmin, xmax, ymin, ymax, zmin, zmax;
+        Real uxmin, uxmax, uymin, uymax, uzmin, uzmax;
+        Real gmin, gmax, wmin, wmax;
+
+        if (m_fused_particle_sums && m_fused_particle_sums->isComputed(step))
+        {
+            // Extrema already computed (and reduced over MPI ranks) with the other particle diagnostics
+            using FPR = FusedParticleReductions;
+            const auto& fpr = *m_fused_particle_sums;
+            xmin  = fpr.Min(i_s, FPR::ext_x);
+            xmax  = fpr.Max(i_s, FPR::ext_x);
+            ymin  = fpr.Min(i_s, FPR::ext_y);
+            ymax  = fpr.Max(i_s, FPR::ext_y);
+            zmin  = fpr.Min(i_s, FPR::ext_z);
+            zmax  = fpr.Max(i_s, FPR::ext_z);
+            uxmin = fpr.Min(i_s, FPR::ext_ux);
+            uxmax = fpr.Max(i_s, FPR::ext_ux);
+            uymin = fpr.Min(i_s, FPR::ext_uy);
+            uymax = fpr.Max(i_s, FPR::ext_uy);
+            uzmin = fpr.Min(i_s, FPR::ext_uz);
+            uzmax = fpr.Max(i_s, FPR::ext_uz);
+            gmin  = fpr.Min(i_s, FPR::ext_gamma);
+            gmax  = fpr.Max(i_s, FPR::ext_gamma);
+            wmin  = fpr.Min(i_s, FPR::ext_w);
+            wmax  = fpr.Max(i_s, FPR::ext_w);
+        }
+        else
+        {
+            // xmin
 #if (defined WARPX_DIM_RZ)
-        Real xmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(xmin);
+            xmin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
+            ParallelDescriptor::ReduceRealMin(xmin);
 #elif (defined WARPX_DIM_1D_Z)
-        Real xmin = 0.0_rt;
+            xmin = 0.0_rt;
 #else
-        Real xmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMin(xmin);
+            xmin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0); });
+            ParallelDescriptor::ReduceRealMin(xmin);
 #endif
 
-        // xmax
+            // xmax
 #if (defined WARPX_DIM_RZ)
-        Real xmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(xmax);
+            xmax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0)*std::cos(p.rdata(PIdx::theta)); });
+            ParallelDescriptor::ReduceRealMax(xmax);
 #elif (defined WARPX_DIM_1D_Z)
-        Real xmax = 0.0_rt;
+            xmax = 0.0_rt;
 #else
-        Real xmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0); });
-        ParallelDescriptor::ReduceRealMax(xmax);
+            xmax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0); });
+            ParallelDescriptor::ReduceRealMax(xmax);
 #endif
 
-        // ymin
+            // ymin
 #if (defined WARPX_DIM_RZ)
-        Real ymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMin(ymin);
+            ymin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
+            ParallelDescriptor::ReduceRealMin(ymin);
 #elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
-        Real ymin = 0.0_rt;
+            ymin = 0.0_rt;
 #else
-        Real ymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMin(ymin);
+            ymin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(1); });
+            ParallelDescriptor::ReduceRealMin(ymin);
 #endif
 
-        // ymax
+            // ymax
 #if (defined WARPX_DIM_RZ)
-        Real ymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
-        ParallelDescriptor::ReduceRealMax(ymax);
+            ymax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(0)*std::sin(p.rdata(PIdx::theta)); });
+            ParallelDescriptor::ReduceRealMax(ymax);
 #elif (defined WARPX_DIM_XZ || WARPX_DIM_1D_Z)
-        Real ymax = 0.0_rt;
+            ymax = 0.0_rt;
 #else
-        Real ymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(1); });
-        ParallelDescriptor::ReduceRealMax(ymax);
+            ymax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.pos(1); });
+            ParallelDescriptor::ReduceRealMax(ymax);
 #endif
 
-        // zmin
-        Real zmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMin(zmin);
-
-        // zmax
-        Real zmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.pos(index_z); });
-        ParallelDescriptor::ReduceRealMax(zmax);
-
-        // uxmin
-        Real uxmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMin(uxmin);
-
-        // uxmax
-        Real uxmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::ux); });
-        ParallelDescriptor::ReduceRealMax(uxmax);
-
-        // uymin
-        Real uymin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMin(uymin);
-
-        // uymax
-        Real uymax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uy); });
-        ParallelDescriptor::ReduceRealMax(uymax);
-
-        // uzmin
-        Real uzmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMin(uzmin);
-
-        // uzmax
-        Real uzmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::uz); });
-        ParallelDescriptor::ReduceRealMax(uzmax);
-
-        // gmin
-        Real gmin = 0.0_rt;
-        if ( is_photon ) {
-            gmin = ReduceMin( myspc,
+            // zmin
+            zmin = ReduceMin( myspc,
             [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(us*inv_c2);
-            });
-        } else {
-            gmin = ReduceMin( myspc,
+            { return p.pos(index_z); });
+            ParallelDescriptor::ReduceRealMin(zmin);
+
+            // zmax
+            zmax = ReduceMax( myspc,
             [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(1.0_rt + us*inv_c2);
-            });
-        }
-        ParallelDescriptor::ReduceRealMin(gmin);
+            { return p.pos(index_z); });
+            ParallelDescriptor::ReduceRealMax(zmax);
 
-        // gmax
-        Real gmax = 0.0_rt;
-        if ( is_photon ) {
-            gmax = ReduceMax( myspc,
+            // uxmin
+            uxmin = ReduceMin( myspc,
             [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(us*inv_c2);
-            });
-        } else {
-            gmax = ReduceMax( myspc,
+            { return p.rdata(PIdx::ux); });
+            ParallelDescriptor::ReduceRealMin(uxmin);
+
+            // uxmax
+            uxmax = ReduceMax( myspc,
             [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-            {
-                Real ux = p.rdata(PIdx::ux);
-                Real uy = p.rdata(PIdx::uy);
-                Real uz = p.rdata(PIdx::uz);
-                Real us = ux*ux + uy*uy + uz*uz;
-                return std::sqrt(1.0_rt + us*inv_c2);
-            });
+            { return p.rdata(PIdx::ux); });
+            ParallelDescriptor::ReduceRealMax(uxmax);
+
+            // uymin
+            uymin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::uy); });
+            ParallelDescriptor::ReduceRealMin(uymin);
+
+            // uymax
+            uymax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::uy); });
+            ParallelDescriptor::ReduceRealMax(uymax);
+
+            // uzmin
+            uzmin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::uz); });
+            ParallelDescriptor::ReduceRealMin(uzmin);
+
+            // uzmax
+            uzmax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::uz); });
+            ParallelDescriptor::ReduceRealMax(uzmax);
+
+            // gmin
+            gmin = 0.0_rt;
+            if ( is_photon ) {
+                gmin = ReduceMin( myspc,
+                [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+                {
+                    Real ux = p.rdata(PIdx::ux);
+                    Real uy = p.rdata(PIdx::uy);
+                    Real uz = p.rdata(PIdx::uz);
+                    Real us = ux*ux + uy*uy + uz*uz;
+                    return std::sqrt(us*inv_c2);
+                });
+            } else {
+                gmin = ReduceMin( myspc,
+                [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+                {
+                    Real ux = p.rdata(PIdx::ux);
+                    Real uy = p.rdata(PIdx::uy);
+                    Real uz = p.rdata(PIdx::uz);
+                    Real us = ux*ux + uy*uy + uz*uz;
+                    return std::sqrt(1.0_rt + us*inv_c2);
+                });
+            }
+            ParallelDescriptor::ReduceRealMin(gmin);
+
+            // gmax
+            gmax = 0.0_rt;
+            if ( is_photon ) {
+                gmax = ReduceMax( myspc,
+                [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+                {
+                    Real ux = p.rdata(PIdx::ux);
+                    Real uy = p.rdata(PIdx::uy);
+                    Real uz = p.rdata(PIdx::uz);
+                    Real us = ux*ux + uy*uy + uz*uz;
+                    return std::sqrt(us*inv_c2);
+                });
+            } else {
+                gmax = ReduceMax( myspc,
+                [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+                {
+                    Real ux = p.rdata(PIdx::ux);
+                    Real uy = p.rdata(PIdx::uy);
+                    Real uz = p.rdata(PIdx::uz);
+                    Real us = ux*ux + uy*uy + uz*uz;
+                    return std::sqrt(1.0_rt + us*inv_c2);
+                });
+            }
+            ParallelDescriptor::ReduceRealMax(gmax);
+
+            // wmin
+            wmin = ReduceMin( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::w); });
+            ParallelDescriptor::ReduceRealMin(wmin);
+
+            // wmax
+            wmax = ReduceMax( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p)
+            { return p.rdata(PIdx::w); });
+            ParallelDescriptor::ReduceRealMax(wmax);
         }
-        ParallelDescriptor::ReduceRealMax(gmax);
-
-        // wmin
-        Real wmin = ReduceMin( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMin(wmin);
-
-        // wmax
-        Real wmax = ReduceMax( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p)
-        { return p.rdata(PIdx::w); });
-        ParallelDescriptor::ReduceRealMax(wmax);
 
 #if (defined WARPX_QED)
         // get number of level (int)
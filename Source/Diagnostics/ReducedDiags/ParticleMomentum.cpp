@@ -7,6 +7,7 @@
 
 #include "ParticleMomentum.H"
 
+#include "Diagnostics/ReducedDiags/FusedParticleReductions.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/SpeciesPhysicalProperties.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -146,32 +147,48 @@ void ParticleMomentum::ComputeDiags (int step)
 
         using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        // Use amrex::ParticleReduce to compute the sum of the momenta and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Px, Py, Pz, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uy = p.rdata(PIdx::uy);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                return {w*m*ux, w*m*uy, w*m*uz, w};
-            },
-            reduce_ops);
-
-        amrex::Real Px = amrex::get<0>(r);
-        amrex::Real Py = amrex::get<1>(r);
-        amrex::Real Pz = amrex::get<2>(r);
-        amrex::Real Ws = amrex::get<3>(r);
-
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Px, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Py, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Pz, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws, ParallelDescriptor::IOProcessorNumber());
+        amrex::Real Px = 0.0_rt;
+        amrex::Real Py = 0.0_rt;
+        amrex::Real Pz = 0.0_rt;
+        amrex::Real Ws = 0.0_rt;
+
+        if (m_fused_particle_sums && m_fused_particle_sums->isComputed(step))
+        {
+            // Sums already computed (and reduced over MPI ranks) for all particle diagnostics
+            Px = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::px);
+            Py = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::py);
+            Pz = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::pz);
+            Ws = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::weight);
+        }
+        else
+        {
+            // Use amrex::ParticleReduce to compute the sum of the momenta and weights of all particles
+            // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
+            // the result r is the tuple (Px, Py, Pz, Ws)
+            amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
+            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
+                myspc,
+                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
+                {
+                    const amrex::Real w  = p.rdata(PIdx::w);
+                    const amrex::Real ux = p.rdata(PIdx::ux);
+                    const amrex::Real uy = p.rdata(PIdx::uy);
+                    const amrex::Real uz = p.rdata(PIdx::uz);
+                    return {w*m*ux, w*m*uy, w*m*uz, w};
+                },
+                reduce_ops);
+
+            Px = amrex::get<0>(r);
+            Py = amrex::get<1>(r);
+            Pz = amrex::get<2>(r);
+            Ws = amrex::get<3>(r);
+
+            // Reduced sum over MPI ranks
+            ParallelDescriptor::ReduceRealSum(Px, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealSum(Py, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealSum(Pz, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceRealSum(Ws, ParallelDescriptor::IOProcessorNumber());
+        }
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
@@ -7,6 +7,7 @@
 
 #include "ParticleNumber.H"
 
+#include "Diagnostics/ReducedDiags/FusedParticleReductions.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -115,21 +116,32 @@ void ParticleNumber::ComputeDiags (int step)
         // get WarpXParticleContainer class object
         const auto & myspc = mypc.GetParticleContainer(i_s);
 
-        // Save total number of macroparticles for this species
-        m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
+        amrex::Real Wtot = 0.0_rt;
+        if (m_fused_particle_sums && m_fused_particle_sums->isComputed(step))
+        {
+            // Sums already computed (and reduced over MPI ranks) for all particle diagnostics
+            m_data[idx_first_species_macroparticles + i_s] =
+                static_cast<amrex::Real>(m_fused_particle_sums->NumParticles(i_s));
+            Wtot = m_fused_particle_sums->Sum(i_s, FusedParticleReductions::weight);
+        }
+        else
+        {
+            // Save total number of macroparticles for this species
+            m_data[idx_first_species_macroparticles + i_s] = myspc.TotalNumberOfParticles();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
+            using PType = typename WarpXParticleContainer::SuperParticleType;
 
-        // Reduction to compute sum of weights for this species
-        auto Wtot = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> amrex::Real
-        {
-            return p.rdata(PIdx::w);
-        });
+            // Reduction to compute sum of weights for this species
+            Wtot = ReduceSum( myspc,
+            [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> amrex::Real
+            {
+                return p.rdata(PIdx::w);
+            });
 
-        // MPI reduction
-        amrex::ParallelDescriptor::ReduceRealSum
-            (Wtot, amrex::ParallelDescriptor::IOProcessorNumber());
+            // MPI reduction
+            amrex::ParallelDescriptor::ReduceRealSum
+                (Wtot, amrex::ParallelDescriptor::IOProcessorNumber());
+        }
 
         // Save sum of particles weight for this species
         m_data[idx_first_species_sum_weight + i_s] = Wtot;
@@ -0,0 +1,92 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "PoissonSolverConvergence.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "FieldSolver/ElectrostaticSolver.H"
+#include "Utils/IntervalsParser.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+PoissonSolverConvergence::PoissonSolverConvergence (std::string rd_name)
+    : ReducedDiags{rd_name}
+{
+    // read number of levels
+    int nLevel = 0;
+    ParmParse pp_amr("amr");
+    pp_amr.query("max_level", nLevel);
+    nLevel += 1;
+
+    // resize data array: 3 values per level
+    m_data.resize(3*nLevel, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int lev = 0; lev < nLevel; ++lev)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]iterations_lev" + std::to_string(lev) + "()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]initial_residual_lev" + std::to_string(lev) + "(V/m^2)";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]final_residual_lev" + std::to_string(lev) + "(V/m^2)";
+            }
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+
+// Get the convergence of the last Poisson solve
+void PoissonSolverConvergence::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get the statistics recorded by the last solve
+    const auto & stats = WarpX::GetInstance().getPoissonSolverStats();
+
+    const int nLevel = static_cast<int>(m_data.size())/3;
+    const int nStats = std::min(nLevel, static_cast<int>(stats.size()));
+    std::fill(m_data.begin(), m_data.end(), 0.0_rt);
+    for (int lev = 0; lev < nStats; ++lev)
+    {
+        m_data[3*lev]   = stats[lev].num_iters;
+        m_data[3*lev+1] = stats[lev].initial_residual;
+        m_data[3*lev+2] = stats[lev].final_residual;
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [number of iterations at level 0,
+     *   initial residual at level 0,
+     *   final residual at level 0,
+     *   number of iterations at level 1,
+     *   ......] */
+}
@@ -15,8 +15,10 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 
 using namespace amrex;
 
@@ -35,6 +37,18 @@ ReducedDiags::ReducedDiags (std::string rd_name)
     // read extension
     pp_rd_name.query("extension", m_extension);
 
+    // read output format and buffer size
+    std::string output_format = "text";
+    pp_rd_name.query("output_format", output_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        output_format == "text" || output_format == "binary" || output_format == "openpmd",
+        m_rd_name + ".output_format must be text, binary or openpmd");
+    m_binary_output = (output_format == "binary");
+    m_openpmd_output = (output_format == "openpmd");
+    pp_rd_name.query("buffer_size", m_buffer_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_buffer_size > 0, m_rd_name + ".buffer_size must be positive");
+
     // check if it is a restart run
     std::string restart_chkfile = "";
     ParmParse pp_amr("amr");
@@ -53,6 +67,11 @@ ReducedDiags::ReducedDiags (std::string rd_name)
         {
             std::ofstream ofs{m_path+m_rd_name+"."+m_extension, std::ios::trunc};
             ofs.close();
+            if (m_binary_output)
+            {
+                std::ofstream ofs_bin{DataFileName(), std::ios::trunc | std::ios::binary};
+                ofs_bin.close();
+            }
         }
     }
 
@@ -94,9 +113,18 @@ void ReducedDiags::BackwardCompatibility ()
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-        std::ofstream::out | std::ofstream::app};
+    if (m_binary_output)
+    {
+        std::vector<double> row;
+        row.reserve(m_data.size() + 2);
+        row.push_back(step+1);
+        row.push_back(WarpX::GetInstance().gett_new(0));
+        row.insert(row.end(), m_data.begin(), m_data.end());
+        BufferBinaryRow(row);
+        return;
+    }
+
+    std::ostringstream ofs;
 
     // write step
     ofs << step+1;
@@ -115,9 +143,51 @@ void ReducedDiags::WriteToFile (int step) const
     // end loop over data size
 
     // end line
-    ofs << std::endl;
+    ofs << '\n';
 
-    // close file
-    ofs.close();
+    BufferTextRow(ofs.str());
 }
 // end ReducedDiags::WriteToFile
+
+std::string ReducedDiags::DataFileName () const
+{
+    return m_path + m_rd_name + "." + (m_binary_output ? std::string("bin") : m_extension);
+}
+
+void ReducedDiags::BufferTextRow (std::string const& row) const
+{
+    m_text_buffer += row;
+    if (++m_buffered_rows >= m_buffer_size) FlushBuffer();
+}
+
+void ReducedDiags::BufferBinaryRow (std::vector<double> const& row) const
+{
+    const std::int64_t n = row.size();
+    const char* n_begin = reinterpret_cast<const char*>(&n);
+    const char* row_begin = reinterpret_cast<const char*>(row.data());
+    m_binary_buffer.insert(m_binary_buffer.end(), n_begin, n_begin + sizeof(n));
+    m_binary_buffer.insert(m_binary_buffer.end(), row_begin, row_begin + n*sizeof(double));
+    if (++m_buffered_rows >= m_buffer_size) FlushBuffer();
+}
+
+void ReducedDiags::FlushBuffer () const
+{
+    if (m_buffered_rows == 0) return;
+
+    if (m_binary_output)
+    {
+        std::ofstream ofs{DataFileName(),
+            std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+        ofs.write(m_binary_buffer.data(), m_binary_buffer.size());
+        ofs.close();
+        m_binary_buffer.clear();
+    }
+    else
+    {
+        std::ofstream ofs{DataFileName(), std::ofstream::out | std::ofstream::app};
+        ofs << m_text_buffer;
+        ofs.close();
+        m_text_buffer.clear();
+    }
+    m_buffered_rows = 0;
+}
@@ -34,12 +34,16 @@
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
 #include <AMReX_RealBox.H>
+#include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 #include <AMReX_VisMF.H>
 
 #include <array>
+#include <cmath>
 #include <istream>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 
@@ -62,10 +66,61 @@ WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, in
     std::string DMFileName = chkfile;
     if (!DMFileName.empty() && DMFileName[DMFileName.size()-1] != '/') {DMFileName += '/';}
     DMFileName = amrex::Concatenate(DMFileName + "Level_", lev, 1);
+    std::string NumParticlesFileName = DMFileName + "/NumParticles";
     DMFileName += "/DM";
 
+    // When the distribution mapping of the checkpoint cannot be used (e.g., when
+    // restarting on a different number of MPI ranks), the boxes are distributed
+    // according to their costs in the checkpoint, so that the fields and particles
+    // are directly read on their final MPI rank, without load balancing afterwards
+    const auto NewDMap = [&] () -> amrex::DistributionMapping
+    {
+        if (!load_balance_on_restart || !amrex::FileExists(NumParticlesFileName)) {
+            return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        }
+
+        Vector<char> fileCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(NumParticlesFileName, fileCharPtr);
+        std::string fileCharPtrString(fileCharPtr.dataPtr());
+        std::istringstream NumParticlesFile(fileCharPtrString, std::istringstream::in);
+        NumParticlesFile.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+        int nboxes;
+        NumParticlesFile >> nboxes;
+        if (nboxes != static_cast<int>(ba.size())) {
+            return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        }
+
+        // Heuristic costs (the weights are those of the CPU defaults if they are not set)
+        amrex::Real cells_wt = costs_heuristic_cells_wt;
+        amrex::Real particles_wt = costs_heuristic_particles_wt;
+        if (cells_wt <= 0._rt && particles_wt <= 0._rt) {
+            cells_wt = 0.1_rt;
+            particles_wt = 0.9_rt;
+        }
+        amrex::Vector<amrex::Real> box_costs(nboxes);
+        for (int i = 0; i < nboxes; ++i) {
+            amrex::Long np;
+            NumParticlesFile >> np;
+            box_costs[i] = cells_wt*static_cast<amrex::Real>(ba[i].numPts())
+                + particles_wt*static_cast<amrex::Real>(np);
+        }
+
+        if (verbose) {
+            amrex::Print() << Utils::TextMsg::Info(
+                "Distributing the " + std::to_string(nboxes) + " boxes of level " + std::to_string(lev)
+                + " on " + std::to_string(ParallelDescriptor::NProcs())
+                + " MPI ranks according to their costs in the checkpoint");
+        }
+        const amrex::Real nprocs = ParallelDescriptor::NProcs();
+        const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
+        return (load_balance_with_sfc)
+            ? amrex::DistributionMapping::makeSFC(box_costs, ba)
+            : amrex::DistributionMapping::makeKnapSack(box_costs, nmax);
+    };
+
     if (!amrex::FileExists(DMFileName)) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return NewDMap();
     }
 
     Vector<char> fileCharPtr;
@@ -78,13 +133,13 @@ WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, in
     int nprocs_in_checkpoint;
     DMFile >> nprocs_in_checkpoint;
     if (nprocs_in_checkpoint != ParallelDescriptor::NProcs()) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return NewDMap();
     }
 
     amrex::DistributionMapping dm;
     dm.readFrom(DMFile);
     if (dm.size() != ba.size()) {
-        return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
+        return NewDMap();
     }
 
     return dm;
@@ -98,6 +153,47 @@ WarpX::InitFromCheckpoint ()
     amrex::Print()<< Utils::TextMsg::Info(
         "restart from checkpoint " + restart_chkfile);
 
+    // Incremental checkpoint: the data that did not change since the base
+    // checkpoint was not written, and is read from the base checkpoint
+    std::string base_chkfile;
+    std::set<std::string> in_base;
+    if (amrex::FileExists(restart_chkfile + "/WarpXIncremental")) {
+        Vector<char> fileCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(restart_chkfile + "/WarpXIncremental", fileCharPtr);
+        std::string fileCharPtrString(fileCharPtr.dataPtr());
+        std::istringstream is(fileCharPtrString, std::istringstream::in);
+        is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+        std::getline(is, base_chkfile);
+        // the path of the base checkpoint is relative to the incremental checkpoint
+        if (!base_chkfile.empty() && base_chkfile[0] != '/') {
+            std::string chkdir = restart_chkfile;
+            if (!chkdir.empty() && chkdir.back() != '/') chkdir += '/';
+            base_chkfile = chkdir + base_chkfile;
+        }
+        std::size_t nskipped;
+        is >> nskipped;
+        GotoNextLine(is);
+        for (std::size_t i = 0; i < nskipped; ++i) {
+            std::string key;
+            std::getline(is, key);
+            in_base.insert(key);
+        }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            amrex::FileExists(base_chkfile + "/WarpXHeader"),
+            "The base checkpoint " + base_chkfile + " of the incremental checkpoint "
+            + restart_chkfile + " was not found");
+        amrex::Print()<< Utils::TextMsg::Info(
+            std::to_string(in_base.size()) + " fields and species are read from the base checkpoint "
+            + base_chkfile);
+    }
+    // Checkpoint that holds the field `name` of level `lev`
+    const auto chkfile = [&] (int lev, const std::string& name) -> const std::string&
+    {
+        return in_base.count(amrex::Concatenate(level_prefix, lev, 1) + "/" + name) ?
+            base_chkfile : restart_chkfile;
+    };
+
     // Header
     {
         std::string File(restart_chkfile + "/WarpXHeader");
@@ -249,85 +345,85 @@ WarpX::InitFromCheckpoint ()
         }
 
         VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ex_fp"), level_prefix, "Ex_fp"));
         VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ey_fp"), level_prefix, "Ey_fp"));
         VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ez_fp"), level_prefix, "Ez_fp"));
 
         VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bx_fp"), level_prefix, "Bx_fp"));
         VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "By_fp"), level_prefix, "By_fp"));
         VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+                    amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bz_fp"), level_prefix, "Bz_fp"));
 
         if (WarpX::fft_do_time_averaging)
         {
             VisMF::Read(*Efield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ex_avg_fp"), level_prefix, "Ex_avg_fp"));
             VisMF::Read(*Efield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ey_avg_fp"), level_prefix, "Ey_avg_fp"));
             VisMF::Read(*Efield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ez_avg_fp"), level_prefix, "Ez_avg_fp"));
 
             VisMF::Read(*Bfield_avg_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bx_avg_fp"), level_prefix, "Bx_avg_fp"));
             VisMF::Read(*Bfield_avg_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "By_avg_fp"), level_prefix, "By_avg_fp"));
             VisMF::Read(*Bfield_avg_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bz_avg_fp"), level_prefix, "Bz_avg_fp"));
         }
 
         if (is_synchronized) {
             VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jx_fp"), level_prefix, "jx_fp"));
             VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jy_fp"), level_prefix, "jy_fp"));
             VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jz_fp"), level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
             VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ex_cp"), level_prefix, "Ex_cp"));
             VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ey_cp"), level_prefix, "Ey_cp"));
             VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ez_cp"), level_prefix, "Ez_cp"));
 
             VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bx_cp"), level_prefix, "Bx_cp"));
             VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "By_cp"), level_prefix, "By_cp"));
             VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+                        amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bz_cp"), level_prefix, "Bz_cp"));
 
             if (WarpX::fft_do_time_averaging)
             {
                 VisMF::Read(*Efield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ex_avg_cp"), level_prefix, "Ex_avg_cp"));
                 VisMF::Read(*Efield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ey_avg_cp"), level_prefix, "Ey_avg_cp"));
                 VisMF::Read(*Efield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Ez_avg_cp"), level_prefix, "Ez_avg_cp"));
 
                 VisMF::Read(*Bfield_avg_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bx_avg_cp"), level_prefix, "Bx_avg_cp"));
                 VisMF::Read(*Bfield_avg_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "By_avg_cp"), level_prefix, "By_avg_cp"));
                 VisMF::Read(*Bfield_avg_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "Bz_avg_cp"), level_prefix, "Bz_avg_cp"));
             }
 
             if (is_synchronized) {
                 VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jx_cp"), level_prefix, "jx_cp"));
                 VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jy_cp"), level_prefix, "jy_cp"));
                 VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                            amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "jz_cp"), level_prefix, "jz_cp"));
             }
         }
     }
@@ -337,10 +433,10 @@ WarpX::InitFromCheckpoint ()
     {
         for (int lev = 0; lev < nlevs; ++lev) {
             if (pml[lev])
-                pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml"));
+                pml[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "pml"), level_prefix, "pml"));
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_PSATD)
             if (pml_rz[lev])
-                pml_rz[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "pml_rz"));
+                pml_rz[lev]->Restart(amrex::MultiFabFileFullPrefix(lev, chkfile(lev, "pml_rz"), level_prefix, "pml_rz"));
 #endif
         }
     }
@@ -349,7 +445,14 @@ WarpX::InitFromCheckpoint ()
 
     // Initialize particles
     mypc->AllocData();
-    mypc->Restart(restart_chkfile);
+    std::map<std::string, std::string> species_chkfile;
+    for (const auto& key : in_base) {
+        const std::string prefix = "particles/";
+        if (key.compare(0, prefix.size(), prefix) == 0) {
+            species_chkfile[key.substr(prefix.size())] = base_chkfile;
+        }
+    }
+    mypc->Restart(restart_chkfile, species_chkfile);
 
 }
 
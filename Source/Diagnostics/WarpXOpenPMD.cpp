@@ -43,11 +43,13 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -400,10 +402,14 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     std::map< std::string, std::string > operator_parameters,
     std::string engine_type,
     std::map< std::string, std::string > engine_parameters,
-    std::vector<bool> fieldPMLdirections)
+    std::vector<bool> fieldPMLdirections,
+    std::string particle_operator,
+    std::string field_compressor)
   :m_Series(nullptr),
    m_Encoding(ie),
    m_OpenPMDFileType(std::move(openPMDFileType)),
+   m_ParticleOperator(std::move(particle_operator)),
+   m_FieldCompressor(std::move(field_compressor)),
    m_fieldPMLdirections(std::move(fieldPMLdirections))
 {
   // pick first available backend if default is chosen
@@ -420,6 +426,15 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
 
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
+
+    if (!m_ParticleOperator.empty() && m_OpenPMDFileType != "bp") {
+        ablastr::warn_manager::WMRecordWarning("Diagnostics",
+            "The compression of the particle attributes is only supported with the ADIOS2 "
+            "backend of openPMD and is ignored");
+        m_ParticleOperator.clear();
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_FieldCompressor.empty() || m_OpenPMDFileType == "bp",
+        "The compression of the fields is only supported with the ADIOS2 backend of openPMD");
 }
 
 WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
@@ -614,15 +629,14 @@ WarpXOpenPMDPlot::WriteOpenPMDParticles (const amrex::Vector<ParticleDiag>& part
                                  compileParser<ParticleDiag::m_nvars>
                                      (particle_diags[i].m_particle_filter_parser.get()),
                                  pc->getMass());
-      parser_filter.m_units = InputUnits::SI;
+      // the filters see the live particles, which are in WarpX units
+      parser_filter.m_units = InputUnits::WarpX;
       GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
                                            particle_diags[i].m_diag_domain);
 
       if (isBTD || use_pinned_pc) {
           tmp.copyParticles(*pinned_pc, true);
-          particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
       } else {
-          particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
           using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
           tmp.copyParticles(*pc,
                             [=] AMREX_GPU_HOST_DEVICE (const SrcData& src, int ip, const amrex::RandomEngine& engine)
@@ -631,8 +645,9 @@ WarpXOpenPMDPlot::WriteOpenPMDParticles (const amrex::Vector<ParticleDiag>& part
               return random_filter(p, engine) * uniform_filter(p, engine)
                      * parser_filter(p, engine) * geometry_filter(p, engine);
           }, true);
-          particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
       }
+      // convert only the selected copy: the live species is never modified
+      particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
 
     // real_names contains a list of all real particle attributes.
     // real_flags is 1 or 0, whether quantity is dumped or not.
@@ -837,8 +852,7 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
                       const amrex::Vector<std::string>& int_comp_names,
                       const unsigned long long np, bool const isBTD) const
 {
-    std::string options = "{}";
-    if (isBTD) options = "{ \"resizable\": true }";
+    std::string const options = ParticleDatasetOptions(isBTD);
     auto dtype_real = openPMD::Dataset(openPMD::determineDatatype<amrex::ParticleReal>(), {np}, options);
     auto dtype_int  = openPMD::Dataset(openPMD::determineDatatype<int>(), {np}, options);
     //
@@ -976,14 +990,38 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
 }
 
 
+std::string
+WarpXOpenPMDPlot::ParticleDatasetOptions (bool const isBTD) const
+{
+    std::string options = "{";
+    if (isBTD) options += " \"resizable\": true";
+    if (!m_ParticleOperator.empty()) {
+        if (isBTD) options += ",";
+        options += " \"adios2\": { \"dataset\": { \"operators\": [ " + m_ParticleOperator + " ] } }";
+    }
+    options += " }";
+    return options;
+}
+
+std::string
+WarpXOpenPMDPlot::FieldDatasetOptions (amrex::Real const error_bound) const
+{
+    using namespace amrex::literals;
+
+    if (m_FieldCompressor.empty() || !(error_bound > 0._rt)) return "{}";
+    std::ostringstream accuracy;
+    accuracy << std::setprecision(17) << error_bound;
+    return "{ \"adios2\": { \"dataset\": { \"operators\": [ { \"type\": \"" + m_FieldCompressor
+        + "\", \"parameters\": { \"accuracy\": \"" + accuracy.str() + "\" } } ] } } }";
+}
+
 void
 WarpXOpenPMDPlot::SetupPos (
     openPMD::ParticleSpecies& currSpecies,
     const unsigned long long& np,
     bool const isBTD)
 {
-  std::string options = "{}";
-  if (isBTD) options = "{ \"resizable\": true }";
+  std::string const options = ParticleDatasetOptions(isBTD);
   auto realType = openPMD::Dataset(openPMD::determineDatatype<amrex::ParticleReal>(), {np}, options);
   auto idType = openPMD::Dataset(openPMD::determineDatatype< uint64_t >(), {np}, options);
 
@@ -1174,7 +1212,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  std::string comp_name,
                                  std::string field_name,
                                  amrex::MultiFab const& mf,
-                                 bool var_in_theta_mode) const
+                                 bool var_in_theta_mode,
+                                 std::string const& dataset_options) const
 {
     auto mesh_comp = mesh[comp_name];
     amrex::Box const & global_box = full_geom.Domain();
@@ -1194,7 +1233,7 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
 
     // Prepare the type of dataset that will be written
     openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    auto const dataset = openPMD::Dataset(datatype, global_size, dataset_options);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1298,7 +1337,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                       const int iteration,
                       const double time,
                       bool isBTD,
-                      const amrex::Geometry& full_BTD_snapshot ) const
+                      const amrex::Geometry& full_BTD_snapshot,
+                      const amrex::Vector<amrex::Real>& field_error_bounds ) const
 {
     //This is AMReX's tiny profiler. Possibly will apply it later
     WARPX_PROFILE("WarpXOpenPMDPlot::WriteOpenPMDFields()");
@@ -1339,6 +1379,27 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
         amrex::Box const & global_box = full_geom.Domain();
 
         int const ncomp = mf[lev].nComp();
+
+        // error bound of the lossy compression of each dataset: the smallest one of
+        // its components (the azimuthal modes in RZ are stored in the same dataset)
+        std::map< std::string, amrex::Real > dataset_error_bound;
+        if ( first_write_to_iteration && !field_error_bounds.empty() ) {
+            for ( int icomp=0; icomp<ncomp; icomp++ ) {
+                auto [varname_no_mode, mode_index] = GetFieldNameModeInt(varnames[icomp]);
+                bool var_in_theta_mode = mode_index != -1;
+                std::string field_name = varname_no_mode;
+                std::string comp_name = openPMD::MeshRecordComponent::SCALAR;
+                GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
+                auto const key = field_name + "/" + comp_name;
+                auto const it = dataset_error_bound.find(key);
+                if (it == dataset_error_bound.end()) {
+                    dataset_error_bound[key] = field_error_bounds[icomp];
+                } else {
+                    it->second = std::min(it->second, field_error_bounds[icomp]);
+                }
+            }
+        }
+
         for ( int icomp=0; icomp<ncomp; icomp++ ) {
             std::string const & varname = varnames[icomp];
 
@@ -1350,6 +1411,9 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
             GetMeshCompNames( lev, varname_no_mode, field_name, comp_name, var_in_theta_mode );
             if ( first_write_to_iteration )
             {
+                auto const bound_it = dataset_error_bound.find(field_name + "/" + comp_name);
+                std::string const dataset_options = FieldDatasetOptions(
+                    bound_it != dataset_error_bound.end() ? bound_it->second : amrex::Real(0.));
                 if (comp_name == openPMD::MeshRecordComponent::SCALAR) {
                     if ( ! meshes.contains(field_name) ) {
                         auto mesh = meshes[field_name];
@@ -1358,7 +1422,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        dataset_options );
                     }
                 } else {
                     auto mesh = meshes[field_name];
@@ -1368,7 +1433,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        dataset_options );
                     }
                 }
             }
@@ -1494,16 +1560,12 @@ WarpXParticleCounter::GetParticleOffsetOfProcessor (
 {
     offset = 0;
 #if defined(AMREX_USE_MPI)
-    std::vector<long> result(m_MPISize, 0);
-    amrex::ParallelGather::Gather (numParticles, result.data(), -1, amrex::ParallelDescriptor::Communicator());
-
-    sum = 0;
-    int const num_results = result.size();
-    for (int i=0; i<num_results; i++) {
-        sum += result[i];
-        if (i<m_MPIRank)
-            offset += result[i];
-    }
+    // exclusive scan for the offset (undefined on the first rank), and sum over all ranks
+    unsigned long long const np = static_cast<unsigned long long>(numParticles);
+    MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+    MPI_Exscan(&np, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    if (m_MPIRank == 0) offset = 0;
+    MPI_Allreduce(&np, &sum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
 #else
     sum = numParticles;
 #endif
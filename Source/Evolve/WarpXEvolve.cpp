@@ -379,6 +379,9 @@ WarpX::Evolve (int numsteps)
     }
     multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
 
+    // write the reduced diagnostics kept in memory
+    reduced_diags->FlushBuffers();
+
     if (do_back_transformed_diagnostics) {
         myBFD->Flush(geom[0]);
     }
@@ -656,7 +659,16 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
     {
         if (do_pml && pml[lev]->ok())
         {
-            pml[lev]->PushPSATD(lev);
+            // each patch is timed separately: its time goes to the costs of its own PML boxes
+            const amrex::Real wt = PMLCostsTimerStart(lev);
+            pml[lev]->PushPSATD(lev, PatchType::fine);
+            PMLCostsTimerStop(lev, PatchType::fine, wt);
+            if (lev > 0)
+            {
+                const amrex::Real wt_cp = PMLCostsTimerStart(lev);
+                pml[lev]->PushPSATD(lev, PatchType::coarse);
+                PMLCostsTimerStop(lev, PatchType::coarse, wt_cp);
+            }
         }
         ApplyEfieldBoundary(lev, PatchType::fine);
         if (lev > 0) ApplyEfieldBoundary(lev, PatchType::coarse);
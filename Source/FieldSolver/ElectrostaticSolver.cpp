@@ -16,6 +16,9 @@
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXUtil.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#if defined(WARPX_USE_PSATD) && !defined(WARPX_DIM_RZ)
+#   include "FieldSolver/SpectralSolver/SpectralPoissonSolver.H"
+#endif
 
 #include <ablastr/fields/PoissonSolver.H>
 #include <ablastr/utils/Communication.H>
@@ -48,7 +51,9 @@
 #   include <AMReX_EBFabFactory.H>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -76,11 +81,56 @@ WarpX::ComputeSpaceChargeField (bool const reset_fields)
         // Loop over the species and add their space-charge contribution to E and B.
         // Note that the fields calculated here does not include the E field
         // due to simulation boundary potentials
+        amrex::Vector<WarpXParticleContainer*> species_with_self_fields;
         for (int ispecies=0; ispecies<mypc->nSpecies(); ispecies++){
             WarpXParticleContainer& species = mypc->GetParticleContainer(ispecies);
             if (species.initialize_self_fields ||
                 (do_electrostatic == ElectrostaticSolverAlgo::Relativistic)) {
-                AddSpaceChargeField(species);
+                species_with_self_fields.push_back(&species);
+            }
+        }
+
+        if (self_fields_group_species) {
+            // Species whose mean velocities agree within the tolerance share a
+            // single deposition of rho and a single Poisson solve
+            // (the mean velocities, reduced over the MPI ranks, are computed once per species
+            // and reused for the mean velocity of the group)
+            bool const local_average = false; // Average across all MPI ranks
+            amrex::Vector<std::array<ParticleReal, 3>> species_beta;
+            for (auto* species : species_with_self_fields) {
+                species_beta.push_back(species->meanParticleVelocity(local_average));
+            }
+            amrex::Vector<bool> grouped(species_with_self_fields.size(), false);
+            for (int i = 0; i < static_cast<int>(species_with_self_fields.size()); ++i) {
+                if (grouped[i]) continue;
+                amrex::Vector<WarpXParticleContainer*> group{species_with_self_fields[i]};
+                amrex::Vector<std::array<ParticleReal, 3>> group_beta{species_beta[i]};
+                for (int j = i+1; j < static_cast<int>(species_with_self_fields.size()); ++j) {
+                    if (grouped[j]) continue;
+                    ParticleReal dbeta = 0._prt;
+                    for (int d = 0; d < 3; ++d) {
+                        dbeta = std::max(dbeta, static_cast<ParticleReal>(
+                            std::abs(species_beta[j][d] - species_beta[i][d])/PhysConst::c));
+                    }
+                    if (dbeta <= self_fields_group_beta_tolerance) {
+                        group.push_back(species_with_self_fields[j]);
+                        group_beta.push_back(species_beta[j]);
+                        grouped[j] = true;
+                    }
+                }
+                // the mean velocities of the species of a group are weighted by their
+                // number of particles (only counted for groups of several species)
+                amrex::Vector<amrex::Real> group_weight(group.size(), 1._rt);
+                if (group.size() > 1u) {
+                    for (int k = 0; k < static_cast<int>(group.size()); ++k) {
+                        group_weight[k] = static_cast<amrex::Real>(group[k]->TotalNumberOfParticles());
+                    }
+                }
+                AddSpaceChargeField(group, group_beta, group_weight);
+            }
+        } else {
+            for (auto* species : species_with_self_fields) {
+                AddSpaceChargeField(*species);
             }
         }
 
@@ -143,6 +193,16 @@ WarpX::AddBoundaryField ()
 
 void
 WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
+{
+    bool const local_average = false; // Average across all MPI ranks
+    AddSpaceChargeField(amrex::Vector<WarpXParticleContainer*>{&pc},
+                        {pc.meanParticleVelocity(local_average)}, {1._rt});
+}
+
+void
+WarpX::AddSpaceChargeField (amrex::Vector<WarpXParticleContainer*> const& species_group,
+                            amrex::Vector<std::array<ParticleReal, 3>> const& species_beta,
+                            amrex::Vector<amrex::Real> const& species_weight)
 {
     WARPX_PROFILE("WarpX::AddSpaceChargeField");
 
@@ -170,24 +230,45 @@ WarpX::AddSpaceChargeField (WarpXParticleContainer& pc)
         phi[lev]->setVal(0.);
     }
 
-    // Deposit particle charge density (source of Poisson solver)
+    // Deposit the charge density of all the species of the group (source of Poisson solver)
     bool const local = false;
     bool const reset = false;
     bool const do_rz_volume_scaling = true;
-    if ( !pc.do_not_deposit) {
-        pc.DepositCharge(rho, local, reset, do_rz_volume_scaling);
+    for (auto* pc : species_group) {
+        if ( !pc->do_not_deposit) {
+            pc->DepositCharge(rho, local, reset, do_rz_volume_scaling);
+        }
     }
 
-    // Get the particle beta vector
-    bool const local_average = false; // Average across all MPI ranks
-    std::array<ParticleReal, 3> beta_pr = pc.meanParticleVelocity(local_average);
-    std::array<Real, 3> beta;
-    for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) beta[i] = beta_pr[i]/PhysConst::c; // Normalize
+    // Get the particle beta vector: weighted average of the species mean velocities
+    std::array<Real, 3> beta = {0._rt};
+    amrex::Real total_weight = 0._rt;
+    for (int k = 0; k < static_cast<int>(species_group.size()); ++k) {
+        for (int i=0 ; i < static_cast<int>(beta.size()) ; i++) {
+            beta[i] += species_weight[k]*species_beta[k][i]/PhysConst::c; // Normalize
+        }
+        total_weight += species_weight[k];
+    }
+    if (total_weight > 0._rt) {
+        for (auto& b : beta) b /= total_weight;
+    }
+
+    // Use the most stringent solver parameters of the group
+    WarpXParticleContainer const& pc0 = *species_group[0];
+    amrex::Real required_precision = pc0.self_fields_required_precision;
+    amrex::Real absolute_tolerance = pc0.self_fields_absolute_tolerance;
+    int max_iters = pc0.self_fields_max_iters;
+    int verbosity = pc0.self_fields_verbosity;
+    for (auto* pc : species_group) {
+        required_precision = std::min(required_precision, pc->self_fields_required_precision);
+        absolute_tolerance = std::min(absolute_tolerance, pc->self_fields_absolute_tolerance);
+        max_iters = std::max(max_iters, pc->self_fields_max_iters);
+        verbosity = std::max(verbosity, pc->self_fields_verbosity);
+    }
 
     // Compute the potential phi, by solving the Poisson equation
-    computePhi( rho, phi, beta, pc.self_fields_required_precision,
-                pc.self_fields_absolute_tolerance, pc.self_fields_max_iters,
-                pc.self_fields_verbosity );
+    computePhi( rho, phi, beta, required_precision,
+                absolute_tolerance, max_iters, verbosity );
 
     // Compute the corresponding electric and magnetic field, from the potential phi
     computeE( Efield_fp, phi, beta );
@@ -238,6 +319,9 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     // Todo: use simpler finite difference form with beta=0
     std::array<Real, 3> beta = {0._rt};
 
+    // extrapolate the initial guess from the previous solutions
+    if (self_fields_guess_order > 0) ExtrapolatePhiGuess();
+
     // set the boundary potentials appropriately
     setPhiBC(phi_fp);
 
@@ -259,6 +343,47 @@ WarpX::AddSpaceChargeFieldLabFrame ()
     computeB( Bfield_fp, phi_fp, beta );
 }
 
+void
+WarpX::ExtrapolatePhiGuess ()
+{
+    WARPX_PROFILE("WarpX::ExtrapolatePhiGuess");
+
+    // phi_fp holds the last solution, if any, and m_phi_history the ones before
+    int const n_solutions = std::min(m_num_phi_solutions, self_fields_guess_order + 1);
+    m_num_phi_solutions++;
+    if (n_solutions == 0) return;
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        auto& history = m_phi_history[lev];
+
+        // save the last solution, recycling the buffer of the oldest one
+        // if it is no longer needed
+        std::unique_ptr<MultiFab> last;
+        if (static_cast<int>(history.size()) > self_fields_guess_order) {
+            last = std::move(history.back());
+            history.pop_back();
+        } else {
+            last = std::make_unique<MultiFab>(phi_fp[lev]->boxArray(), phi_fp[lev]->DistributionMap(),
+                                              phi_fp[lev]->nComp(), phi_fp[lev]->nGrowVect());
+        }
+        MultiFab::Copy(*last, *phi_fp[lev], 0, 0, phi_fp[lev]->nComp(), phi_fp[lev]->nGrowVect());
+
+        // linear:    phi^{n+1} = 2 phi^n - phi^{n-1}
+        // quadratic: phi^{n+1} = 3 phi^n - 3 phi^{n-1} + phi^{n-2}
+        if (n_solutions == 2) {
+            MultiFab::LinComb(*phi_fp[lev], 2._rt, *last, 0, -1._rt, *history[0], 0,
+                              0, phi_fp[lev]->nComp(), phi_fp[lev]->nGrowVect());
+        } else if (n_solutions == 3) {
+            MultiFab::LinComb(*phi_fp[lev], 3._rt, *last, 0, -3._rt, *history[0], 0,
+                              0, phi_fp[lev]->nComp(), phi_fp[lev]->nGrowVect());
+            MultiFab::Saxpy(*phi_fp[lev], 1._rt, *history[1],
+                            0, 0, phi_fp[lev]->nComp(), phi_fp[lev]->nGrowVect());
+        }
+
+        history.insert(history.begin(), std::move(last));
+    }
+}
+
 /* Compute the potential `phi` by solving the Poisson equation with `rho` as
    a source, assuming that the source moves at a constant speed \f$\vec{\beta}\f$.
    This uses the amrex solver.
@@ -285,6 +410,22 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
                    int const max_iters,
                    int const verbosity) const
 {
+#if defined(WARPX_USE_PSATD) && !defined(WARPX_DIM_RZ) && !defined(WARPX_DIM_1D_Z)
+    if (poisson_solver_id == PoissonSolverAlgo::FFT) {
+        if (!m_spectral_poisson_solver) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                Geom(0).isAllPeriodic() || !Geom(0).isAnyPeriodic(),
+                "warpx.poisson_solver = fft requires the domain to be either periodic "
+                "or open in all directions");
+            m_spectral_poisson_solver = std::make_unique<SpectralPoissonSolver>(
+                Geom(0), Geom(0).isAllPeriodic());
+        }
+        m_spectral_poisson_solver->solve(*phi[0], *rho[0], beta);
+        m_poisson_solver_stats.assign(1, ElectrostaticSolver::PoissonSolverStats{});
+        return;
+    }
+#endif
+
     // create a vector to our fields, sorted by level
     amrex::Vector<amrex::MultiFab*> sorted_rho;
     amrex::Vector<amrex::MultiFab*> sorted_phi;
@@ -293,7 +434,7 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         sorted_phi.emplace_back(phi[lev].get());
     }
 
-    std::optional<ElectrostaticSolver::EBCalcEfromPhiPerLevel> post_phi_calculation;
+    std::optional<ElectrostaticSolver::EBCalcEfromPhiPerLevel> eb_calc_e;
 #if defined(AMREX_USE_EB)
     // EB: use AMReX to directly calculate the electric field since with EB's the
     // simple finite difference scheme in WarpX::computeE sometimes fails
@@ -323,7 +464,7 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
 #   endif
             );
         }
-        post_phi_calculation = ElectrostaticSolver::EBCalcEfromPhiPerLevel(e_field);
+        eb_calc_e = ElectrostaticSolver::EBCalcEfromPhiPerLevel(e_field);
     }
 
     std::optional<amrex::Vector<amrex::EBFArrayBoxFactory const *> > eb_farray_box_factory;
@@ -338,6 +479,14 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
     std::optional<amrex::Vector<amrex::FArrayBoxFactory const *> > eb_farray_box_factory;
 #endif
 
+    if (self_fields_reuse_solver && !m_poisson_solver_cache) {
+        m_poisson_solver_cache = std::make_unique<ablastr::fields::PoissonSolverCache>();
+    }
+
+    // record the convergence of the solver (and calculate E with EB)
+    std::optional<ElectrostaticSolver::PostPhiCalculation> post_phi_calculation =
+        ElectrostaticSolver::PostPhiCalculation(&m_poisson_solver_stats, eb_calc_e);
+
     ablastr::fields::computePhi(
         sorted_rho,
         sorted_phi,
@@ -354,7 +503,8 @@ WarpX::computePhi (const amrex::Vector<std::unique_ptr<amrex::MultiFab> >& rho,
         this->ref_ratio,
         post_phi_calculation,
         gett_new(0),
-        eb_farray_box_factory
+        eb_farray_box_factory,
+        m_poisson_solver_cache.get()
     );
 
 }
@@ -6,7 +6,9 @@
  */
 #include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
 
+#include "BoundaryConditions/PML.H"
 #include "BoundaryConditions/PMLComponent.H"
+#include "BoundaryConditions/WarpX_PML_kernels.H"
 
 #ifndef WARPX_DIM_RZ
 #   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
@@ -44,26 +46,31 @@ void FiniteDifferenceSolver::EvolveBPML (
     std::array< amrex::MultiFab*, 3 > Bfield,
     std::array< amrex::MultiFab*, 3 > const Efield,
     amrex::Real const dt,
-    const bool dive_cleaning) {
+    const bool dive_cleaning,
+    MultiSigmaBox const* damping_sigba,
+    const bool divb_cleaning) {
 
    // Select algorithm (The choice of algorithm is a runtime option,
    // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
-    amrex::ignore_unused(Bfield, Efield, dt, dive_cleaning);
+    amrex::ignore_unused(Bfield, Efield, dt, dive_cleaning, damping_sigba, divb_cleaning);
     amrex::Abort(Utils::TextMsg::Err(
         "PML are not implemented in cylindrical geometry."));
 #else
     if (m_do_nodal) {
 
-        EvolveBPMLCartesian <CartesianNodalAlgorithm> (Bfield, Efield, dt, dive_cleaning);
+        EvolveBPMLCartesian <CartesianNodalAlgorithm> (
+            Bfield, Efield, dt, dive_cleaning, damping_sigba, divb_cleaning);
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee || m_fdtd_algo == MaxwellSolverAlgo::ECT) {
 
-        EvolveBPMLCartesian <CartesianYeeAlgorithm> (Bfield, Efield, dt, dive_cleaning);
+        EvolveBPMLCartesian <CartesianYeeAlgorithm> (
+            Bfield, Efield, dt, dive_cleaning, damping_sigba, divb_cleaning);
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
-        EvolveBPMLCartesian <CartesianCKCAlgorithm> (Bfield, Efield, dt, dive_cleaning);
+        EvolveBPMLCartesian <CartesianCKCAlgorithm> (
+            Bfield, Efield, dt, dive_cleaning, damping_sigba, divb_cleaning);
 
     } else {
         amrex::Abort(Utils::TextMsg::Err(
@@ -80,7 +87,14 @@ void FiniteDifferenceSolver::EvolveBPMLCartesian (
     std::array< amrex::MultiFab*, 3 > Bfield,
     std::array< amrex::MultiFab*, 3 > const Efield,
     amrex::Real const dt,
-    const bool dive_cleaning) {
+    const bool dive_cleaning,
+    MultiSigmaBox const* damping_sigba,
+    const bool divb_cleaning) {
+
+    const bool do_damping = (damping_sigba != nullptr);
+    const amrex::IntVect Bx_stag = Bfield[0]->ixType().toIntVect();
+    const amrex::IntVect By_stag = Bfield[1]->ixType().toIntVect();
+    const amrex::IntVect Bz_stag = Bfield[2]->ixType().toIntVect();
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -109,6 +123,10 @@ void FiniteDifferenceSolver::EvolveBPMLCartesian (
         Box const& tby  = mfi.tilebox(Bfield[1]->ixType().ixType());
         Box const& tbz  = mfi.tilebox(Bfield[2]->ixType().ixType());
 
+        // Damping factors, only used if the damping is fused with the update
+        PMLDampingFactors d;
+        if (do_damping) d = PMLDampingFactors((*damping_sigba)[mfi]);
+
         // Loop over the cells and update the fields
         amrex::ParallelFor(tbx, tby, tbz,
 
@@ -131,6 +149,12 @@ void FiniteDifferenceSolver::EvolveBPMLCartesian (
                     T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k, PMLComp::zx)
                   + T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k, PMLComp::zy)
                   + UpwardDy_Ez_zz);
+
+                if (do_damping) {
+                    warpx_damp_pml_bx(i, j, k, Bx, Bx_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, divb_cleaning);
+                }
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
@@ -152,6 +176,12 @@ void FiniteDifferenceSolver::EvolveBPMLCartesian (
                     UpwardDz_Ex_xx
                   + T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k, PMLComp::xy)
                   + T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k, PMLComp::xz));
+
+                if (do_damping) {
+                    warpx_damp_pml_by(i, j, k, By, By_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, divb_cleaning);
+                }
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
@@ -173,6 +203,12 @@ void FiniteDifferenceSolver::EvolveBPMLCartesian (
                     T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k, PMLComp::yx)
                   + T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k, PMLComp::yz)
                   + UpwardDx_Ey_yy);
+
+                if (do_damping) {
+                    warpx_damp_pml_bz(i, j, k, Bz, Bz_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, divb_cleaning);
+                }
             }
 
         );
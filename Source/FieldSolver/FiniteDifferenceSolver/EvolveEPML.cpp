@@ -9,6 +9,7 @@
 #include "BoundaryConditions/PML.H"
 #include "BoundaryConditions/PMLComponent.H"
 #include "BoundaryConditions/PML_current.H"
+#include "BoundaryConditions/WarpX_PML_kernels.H"
 #ifndef WARPX_DIM_RZ
 #   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
 #   include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
@@ -50,29 +51,35 @@ void FiniteDifferenceSolver::EvolveEPML (
     std::array< amrex::MultiFab*, 3 > const edge_lengths,
     amrex::MultiFab* const Ffield,
     MultiSigmaBox const& sigba,
-    amrex::Real const dt, bool pml_has_particles ) {
+    amrex::Real const dt, bool pml_has_particles,
+    const bool do_damping,
+    const bool dive_cleaning ) {
 
    // Select algorithm (The choice of algorithm is a runtime option,
    // but we compile code for each algorithm, using templates)
 #ifdef WARPX_DIM_RZ
-    amrex::ignore_unused(Efield, Bfield, Jfield, Ffield, sigba, dt, pml_has_particles, edge_lengths);
+    amrex::ignore_unused(Efield, Bfield, Jfield, Ffield, sigba, dt, pml_has_particles, edge_lengths,
+                         do_damping, dive_cleaning);
     amrex::Abort(Utils::TextMsg::Err(
         "PML are not implemented in cylindrical geometry."));
 #else
     if (m_do_nodal) {
 
         EvolveEPMLCartesian <CartesianNodalAlgorithm> (
-            Efield, Bfield, Jfield, edge_lengths, Ffield, sigba, dt, pml_has_particles );
+            Efield, Bfield, Jfield, edge_lengths, Ffield, sigba, dt, pml_has_particles,
+            do_damping, dive_cleaning );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::Yee || m_fdtd_algo == MaxwellSolverAlgo::ECT) {
 
         EvolveEPMLCartesian <CartesianYeeAlgorithm> (
-            Efield, Bfield, Jfield,  edge_lengths, Ffield, sigba, dt, pml_has_particles );
+            Efield, Bfield, Jfield,  edge_lengths, Ffield, sigba, dt, pml_has_particles,
+            do_damping, dive_cleaning );
 
     } else if (m_fdtd_algo == MaxwellSolverAlgo::CKC) {
 
         EvolveEPMLCartesian <CartesianCKCAlgorithm> (
-            Efield, Bfield, Jfield,  edge_lengths, Ffield, sigba, dt, pml_has_particles );
+            Efield, Bfield, Jfield,  edge_lengths, Ffield, sigba, dt, pml_has_particles,
+            do_damping, dive_cleaning );
 
     } else {
         amrex::Abort(Utils::TextMsg::Err("EvolveEPML: Unknown algorithm"));
@@ -91,9 +98,17 @@ void FiniteDifferenceSolver::EvolveEPMLCartesian (
     std::array< amrex::MultiFab*, 3 > const edge_lengths,
     amrex::MultiFab* const Ffield,
     MultiSigmaBox const& sigba,
-    amrex::Real const dt, bool pml_has_particles ) {
+    amrex::Real const dt, bool pml_has_particles,
+    const bool do_damping,
+    const bool dive_cleaning ) {
 
     Real constexpr c2 = PhysConst::c * PhysConst::c;
+    const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * dt;
+
+    const bool has_F = (Ffield != nullptr);
+    const amrex::IntVect Ex_stag = Efield[0]->ixType().toIntVect();
+    const amrex::IntVect Ey_stag = Efield[1]->ixType().toIntVect();
+    const amrex::IntVect Ez_stag = Efield[2]->ixType().toIntVect();
 
     // Loop through the grids, and over the tiles within each grid
 #ifdef AMREX_USE_OMP
@@ -109,6 +124,37 @@ void FiniteDifferenceSolver::EvolveEPMLCartesian (
         Array4<Real> const& By = Bfield[1]->array(mfi);
         Array4<Real> const& Bz = Bfield[2]->array(mfi);
 
+        // F is used for the grad(F) term
+        // (hyperbolic correction for errors in charge conservation)
+        Array4<Real> F;
+        if (has_F) F = Ffield->array(mfi);
+
+        // Current deposited by the particles in the PML
+        Array4<Real> Jx, Jy, Jz;
+        const Real* sigmaj_x = nullptr;
+        const Real* sigmaj_y = nullptr;
+        const Real* sigmaj_z = nullptr;
+        int x_lo = 0, y_lo = 0, z_lo = 0;
+        if (pml_has_particles) {
+            Jx = Jfield[0]->array(mfi);
+            Jy = Jfield[1]->array(mfi);
+            Jz = Jfield[2]->array(mfi);
+            sigmaj_x = sigba[mfi].sigma[0].data();
+            sigmaj_y = sigba[mfi].sigma[1].data();
+            sigmaj_z = sigba[mfi].sigma[2].data();
+            x_lo = sigba[mfi].sigma[0].lo();
+#if defined(WARPX_DIM_3D)
+            y_lo = sigba[mfi].sigma[1].lo();
+            z_lo = sigba[mfi].sigma[2].lo();
+#else
+            z_lo = sigba[mfi].sigma[1].lo();
+#endif
+        }
+
+        // Damping factors, only used if the damping is fused with the update
+        PMLDampingFactors d;
+        if (do_damping) d = PMLDampingFactors(sigba[mfi]);
+
 #ifdef AMREX_USE_EB
         Array4<Real> const& lx = edge_lengths[0]->array(mfi);
         Array4<Real> const& ly = edge_lengths[1]->array(mfi);
@@ -128,116 +174,98 @@ void FiniteDifferenceSolver::EvolveEPMLCartesian (
         Box const& tey  = mfi.tilebox(Efield[1]->ixType().ixType());
         Box const& tez  = mfi.tilebox(Efield[2]->ixType().ixType());
 
-        // Loop over the cells and update the fields
+        // Loop over the cells and update the fields: each cell only reads B, F and J,
+        // and only writes its own E, so that all the terms are applied in one sweep
         amrex::ParallelFor(tex, tey, tez,
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                if(lx(i, j, k) <= 0) return;
+                if (lx(i, j, k) > 0)
 #endif
-
-                Ex(i, j, k, PMLComp::xz) -= c2 * dt * (
-                    T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k, PMLComp::yx)
-                  + T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k, PMLComp::yz) );
-                Ex(i, j, k, PMLComp::xy) += c2 * dt * (
-                    T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k, PMLComp::zx)
-                  + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k, PMLComp::zy) );
+                {
+                    Ex(i, j, k, PMLComp::xz) -= c2 * dt * (
+                        T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k, PMLComp::yx)
+                      + T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k, PMLComp::yz) );
+                    Ex(i, j, k, PMLComp::xy) += c2 * dt * (
+                        T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k, PMLComp::zx)
+                      + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k, PMLComp::zy) );
+                }
+                if (has_F) {
+                    Ex(i, j, k, PMLComp::xx) += c2 * dt * (
+                        T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::x)
+                      + T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::y)
+                      + T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::z) );
+                }
+                if (pml_has_particles) {
+                    push_ex_pml_current(i, j, k, Ex, Jx,
+                        sigmaj_y, sigmaj_z, y_lo, z_lo, mu_c2_dt);
+                }
+                if (do_damping) {
+                    warpx_damp_pml_ex(i, j, k, Ex, Ex_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, dive_cleaning);
+                }
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                if(ly(i, j, k)<=0) return;
+                if (ly(i, j, k) > 0)
 #endif
-
-                Ey(i, j, k, PMLComp::yx) -= c2 * dt * (
-                    T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k, PMLComp::zx)
-                  + T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k, PMLComp::zy) );
-                Ey(i, j, k, PMLComp::yz) += c2 * dt * (
-                    T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k, PMLComp::xy)
-                  + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k, PMLComp::xz) );
+                {
+                    Ey(i, j, k, PMLComp::yx) -= c2 * dt * (
+                        T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k, PMLComp::zx)
+                      + T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k, PMLComp::zy) );
+                    Ey(i, j, k, PMLComp::yz) += c2 * dt * (
+                        T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k, PMLComp::xy)
+                      + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k, PMLComp::xz) );
+                }
+                if (has_F) {
+                    Ey(i, j, k, PMLComp::yy) += c2 * dt * (
+                        T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::x)
+                      + T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::y)
+                      + T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::z) );
+                }
+                if (pml_has_particles) {
+                    push_ey_pml_current(i, j, k, Ey, Jy,
+                        sigmaj_x, sigmaj_z, x_lo, z_lo, mu_c2_dt);
+                }
+                if (do_damping) {
+                    warpx_damp_pml_ey(i, j, k, Ey, Ey_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, dive_cleaning);
+                }
             },
 
             [=] AMREX_GPU_DEVICE (int i, int j, int k){
 #ifdef AMREX_USE_EB
-                if(lz(i, j, k) <= 0) return;
+                if (lz(i, j, k) > 0)
 #endif
-
-                Ez(i, j, k, PMLComp::zy) -= c2 * dt * (
-                    T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k, PMLComp::xy)
-                  + T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k, PMLComp::xz) );
-                Ez(i, j, k, PMLComp::zx) += c2 * dt * (
-                    T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k, PMLComp::yx)
-                  + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k, PMLComp::yz) );
-            }
-
-        );
-
-        // If F is not a null pointer, further update E using the grad(F) term
-        // (hyperbolic correction for errors in charge conservation)
-        if (Ffield) {
-            // Extract field data for this grid/tile
-            Array4<Real> const& F = Ffield->array(mfi);
-
-            // Loop over the cells and update the fields
-            amrex::ParallelFor(tex, tey, tez,
-
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ex(i, j, k, PMLComp::xx) += c2 * dt * (
-                        T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::x)
-                      + T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::y)
-                      + T_Algo::UpwardDx(F, coefs_x, n_coefs_x, i, j, k, PMLComp::z) );
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
-                    Ey(i, j, k, PMLComp::yy) += c2 * dt * (
-                        T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::x)
-                      + T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::y)
-                      + T_Algo::UpwardDy(F, coefs_y, n_coefs_y, i, j, k, PMLComp::z) );
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k){
+                {
+                    Ez(i, j, k, PMLComp::zy) -= c2 * dt * (
+                        T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k, PMLComp::xy)
+                      + T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k, PMLComp::xz) );
+                    Ez(i, j, k, PMLComp::zx) += c2 * dt * (
+                        T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k, PMLComp::yx)
+                      + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k, PMLComp::yz) );
+                }
+                if (has_F) {
                     Ez(i, j, k, PMLComp::zz) += c2 * dt * (
                         T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k, PMLComp::x)
                       + T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k, PMLComp::y)
                       + T_Algo::UpwardDz(F, coefs_z, n_coefs_z, i, j, k, PMLComp::z) );
                 }
-            );
-        }
-
-        // Update the E field in the PML, using the current
-        // deposited by the particles in the PML
-        if (pml_has_particles) {
-
-            // Extract field data for this grid/tile
-            Array4<Real> const& Jx = Jfield[0]->array(mfi);
-            Array4<Real> const& Jy = Jfield[1]->array(mfi);
-            Array4<Real> const& Jz = Jfield[2]->array(mfi);
-            const Real* sigmaj_x = sigba[mfi].sigma[0].data();
-            const Real* sigmaj_y = sigba[mfi].sigma[1].data();
-            const Real* sigmaj_z = sigba[mfi].sigma[2].data();
-            int const x_lo = sigba[mfi].sigma[0].lo();
-#if defined(WARPX_DIM_3D)
-            int const y_lo = sigba[mfi].sigma[1].lo();
-            int const z_lo = sigba[mfi].sigma[2].lo();
-#else
-            int const y_lo = 0;
-            int const z_lo = sigba[mfi].sigma[1].lo();
-#endif
-            const Real mu_c2_dt = (PhysConst::mu0*PhysConst::c*PhysConst::c) * dt;
-
-            amrex::ParallelFor( tex, tey, tez,
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                    push_ex_pml_current(i, j, k, Ex, Jx,
-                        sigmaj_y, sigmaj_z, y_lo, z_lo, mu_c2_dt);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
-                    push_ey_pml_current(i, j, k, Ey, Jy,
-                        sigmaj_x, sigmaj_z, x_lo, z_lo, mu_c2_dt);
-                },
-                [=] AMREX_GPU_DEVICE (int i, int j, int k) {
+                if (pml_has_particles) {
                     push_ez_pml_current(i, j, k, Ez, Jz,
                         sigmaj_x, sigmaj_y, x_lo, y_lo, mu_c2_dt);
                 }
-            );
-        }
+                if (do_damping) {
+                    warpx_damp_pml_ez(i, j, k, Ez, Ez_stag, d.sigma_fac_x, d.sigma_fac_y, d.sigma_fac_z,
+                                      d.sigma_star_fac_x, d.sigma_star_fac_y, d.sigma_star_fac_z,
+                                      d.x_lo, d.y_lo, d.z_lo, dive_cleaning);
+                }
+            }
+
+        );
 
     }
 
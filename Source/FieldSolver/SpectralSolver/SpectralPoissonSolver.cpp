@@ -0,0 +1,404 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "SpectralPoissonSolver.H"
+
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Vector.H>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace amrex;
+
+namespace
+{
+#if defined(WARPX_DIM_3D)
+    /** Antiderivative of 1/r with respect to x, y and z */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    double AntiderivativeInvR (double const x, double const y, double const z)
+    {
+        double const r = std::sqrt(x*x + y*y + z*z);
+        return y*z*std::log(x + r) + x*z*std::log(y + r) + x*y*std::log(z + r)
+            - 0.5*x*x*std::atan(y*z/(x*r))
+            - 0.5*y*y*std::atan(x*z/(y*r))
+            - 0.5*z*z*std::atan(x*y/(z*r));
+    }
+
+    /** Integral of 1/r over the cell of size h centered on pos */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    double IntegratedInvR (GpuArray<double, 3> const& pos, GpuArray<double, 3> const& h)
+    {
+        double sum = 0.;
+        for (int a = -1; a <= 1; a += 2) {
+            for (int b = -1; b <= 1; b += 2) {
+                for (int c = -1; c <= 1; c += 2) {
+                    sum += a*b*c*AntiderivativeInvR(pos[0] + 0.5*a*h[0],
+                                                    pos[1] + 0.5*b*h[1],
+                                                    pos[2] + 0.5*c*h[2]);
+                }
+            }
+        }
+        return sum;
+    }
+#elif defined(WARPX_DIM_XZ)
+    /** Antiderivative of ln(r) with respect to x and z */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    double AntiderivativeLogR (double const x, double const z)
+    {
+        return 0.5*(x*z*std::log(x*x + z*z) - 3.*x*z
+                    + x*x*std::atan(z/x) + z*z*std::atan(x/z));
+    }
+
+    /** Integral of ln(r) over the cell of size h centered on pos */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    double IntegratedLogR (GpuArray<double, 2> const& pos, GpuArray<double, 2> const& h)
+    {
+        double sum = 0.;
+        for (int a = -1; a <= 1; a += 2) {
+            for (int b = -1; b <= 1; b += 2) {
+                sum += a*b*AntiderivativeLogR(pos[0] + 0.5*a*h[0], pos[1] + 0.5*b*h[1]);
+            }
+        }
+        return sum;
+    }
+#endif
+
+    /** \brief Split `bx` along direction `dir` into (at most) one slab per MPI rank
+     *
+     * \param[in] bx the box to split
+     * \param[in] dir the direction along which the box is split
+     * \param[out] ba the slabs
+     * \param[out] dm the distribution mapping of the slabs: slab i is owned by rank i
+     */
+    void MakeSlabs (Box const& bx, int const dir, BoxArray& ba, DistributionMapping& dm)
+    {
+        int const n = bx.length(dir);
+        int const nslabs = std::min(ParallelDescriptor::NProcs(), n);
+        BoxList bl(bx.ixType());
+        Vector<int> pmap;
+        for (int islab = 0; islab < nslabs; ++islab) {
+            Box slab = bx;
+            slab.setSmall(dir, bx.smallEnd(dir) + (islab*n)/nslabs);
+            slab.setBig(dir, bx.smallEnd(dir) + ((islab+1)*n)/nslabs - 1);
+            bl.push_back(slab);
+            pmap.push_back(islab);
+        }
+        ba = BoxArray(bl);
+        dm = DistributionMapping(pmap);
+    }
+
+    /** Index of the point iv in the data of a box (lower corner lo, lengths len) in
+     *  which the last direction is the fastest index, followed by x, y, ... */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    Long LineIndex (IntVect const& iv, IntVect const& lo, IntVect const& len)
+    {
+        constexpr int last = AMREX_SPACEDIM-1;
+        Long index = 0;
+        for (int idim = last-1; idim >= 0; --idim) {
+            index = index*len[idim] + (iv[idim] - lo[idim]);
+        }
+        return index*len[last] + (iv[last] - lo[last]);
+    }
+}
+
+SpectralPoissonSolver::SpectralPoissonSolver (Geometry const& geom, bool const is_periodic)
+    : m_geom(geom), m_is_periodic(is_periodic)
+{
+#if defined(WARPX_DIM_1D_Z) || defined(WARPX_DIM_RZ)
+    amrex::Abort(Utils::TextMsg::Err(
+        "The FFT Poisson solver is only implemented in Cartesian 2D (XZ) and 3D geometry"));
+#endif
+
+    // Periodic domains: the last node is a copy of the first one.
+    // Open boundaries: zero-padding to twice the number of nodes.
+    Box const nodal_domain = amrex::surroundingNodes(geom.Domain());
+    IntVect const n_nodes = nodal_domain.length();
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_fft_size[idim] = is_periodic ? n_nodes[idim] - 1 : 2*n_nodes[idim];
+    }
+    m_real_lo = nodal_domain.smallEnd();
+
+    // The FFTs along all directions but the last one are performed on slabs
+    // split along the last direction; the FFTs along the last direction on
+    // slabs split along the next-to-last direction
+    constexpr int last = AMREX_SPACEDIM-1;
+    constexpr int next_to_last = AMREX_SPACEDIM-2;
+
+    BoxArray real_ba;
+    DistributionMapping real_dm;
+    MakeSlabs(Box(m_real_lo, m_real_lo + m_fft_size - 1, IndexType::TheNodeType()),
+              last, real_ba, real_dm);
+    m_real_field.define(real_ba, real_dm, 1, 0);
+
+    // Real-to-complex FFT: only about half of the points along x are stored.
+    // The slabs have the same extent along the last direction as the real-space slabs.
+    Box spectralspace_bx(IntVect(0), m_fft_size - 1);
+    spectralspace_bx.setBig(0, m_fft_size[0]/2);
+    BoxArray slabs_ba;
+    DistributionMapping slabs_dm;
+    MakeSlabs(spectralspace_bx, last, slabs_ba, slabs_dm);
+    m_spectral_slabs.define(slabs_ba, slabs_dm, 1, 0);
+
+    BoxArray transposed_ba;
+    DistributionMapping transposed_dm;
+    MakeSlabs(spectralspace_bx, next_to_last, transposed_ba, transposed_dm);
+    m_spectral_transposed.define(transposed_ba, transposed_dm, 1, 0);
+    m_spectral_lines.define(transposed_ba, transposed_dm, 1, 0);
+    if (!is_periodic) m_green_hat.define(transposed_ba, transposed_dm, 1, 0);
+
+    // Batched FFTs along all directions but the last one: one FFT per plane (3D)
+    // or line (2D) of the slab, which are contiguous in memory
+    m_forward_plan = AnyFFT::FFTplans(real_ba, real_dm);
+    m_backward_plan = AnyFFT::FFTplans(real_ba, real_dm);
+    for (MFIter mfi(m_real_field); mfi.isValid(); ++mfi) {
+        IntVect const len = mfi.validbox().length();
+        Complex* const spectral_data = m_spectral_slabs[mfi].dataPtr();
+        m_forward_plan[mfi] = AnyFFT::CreateBatchedPlan(
+            len, len[last], m_real_field[mfi].dataPtr(),
+            reinterpret_cast<AnyFFT::Complex*>(spectral_data),
+            AnyFFT::direction::R2C, AMREX_SPACEDIM-1);
+        m_backward_plan[mfi] = AnyFFT::CreateBatchedPlan(
+            len, len[last], m_real_field[mfi].dataPtr(),
+            reinterpret_cast<AnyFFT::Complex*>(spectral_data),
+            AnyFFT::direction::C2R, AMREX_SPACEDIM-1);
+    }
+
+    // Batched complex-to-complex FFTs along the last direction, in place
+    m_forward_line_plan = AnyFFT::FFTplans(transposed_ba, transposed_dm);
+    m_backward_line_plan = AnyFFT::FFTplans(transposed_ba, transposed_dm);
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        Box const& bx = mfi.validbox();
+        int const n_lines = static_cast<int>(bx.numPts() / bx.length(last));
+        IntVect const line_size(bx.length(last));
+        auto* const lines_data = reinterpret_cast<AnyFFT::Complex*>(m_spectral_lines[mfi].dataPtr());
+        m_forward_line_plan[mfi] = AnyFFT::CreateBatchedPlan(
+            line_size, n_lines, nullptr, lines_data, AnyFFT::direction::C2C_FORWARD, 1);
+        m_backward_line_plan[mfi] = AnyFFT::CreateBatchedPlan(
+            line_size, n_lines, nullptr, lines_data, AnyFFT::direction::C2C_BACKWARD, 1);
+    }
+}
+
+SpectralPoissonSolver::~SpectralPoissonSolver ()
+{
+    for (MFIter mfi(m_real_field); mfi.isValid(); ++mfi) {
+        AnyFFT::DestroyPlan(m_forward_plan[mfi]);
+        AnyFFT::DestroyPlan(m_backward_plan[mfi]);
+    }
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        AnyFFT::DestroyPlan(m_forward_line_plan[mfi]);
+        AnyFFT::DestroyPlan(m_backward_line_plan[mfi]);
+    }
+}
+
+void
+SpectralPoissonSolver::forwardFFT ()
+{
+    WARPX_PROFILE("SpectralPoissonSolver::forwardFFT");
+
+    for (MFIter mfi(m_real_field); mfi.isValid(); ++mfi) {
+        AnyFFT::Execute(m_forward_plan[mfi]);
+    }
+
+    // Transpose: each rank receives whole lines along the last direction
+    m_spectral_transposed.ParallelCopy(m_spectral_slabs);
+
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        Box const& bx = mfi.validbox();
+        IntVect const lo = bx.smallEnd();
+        IntVect const len = bx.length();
+        Array4<Complex const> const& field = m_spectral_transposed.const_array(mfi);
+        Complex* const lines = m_spectral_lines[mfi].dataPtr();
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            lines[LineIndex(IntVect(AMREX_D_DECL(i, j, k)), lo, len)] = field(i, j, k);
+        });
+
+        AnyFFT::Execute(m_forward_line_plan[mfi]);
+    }
+}
+
+void
+SpectralPoissonSolver::backwardFFT ()
+{
+    WARPX_PROFILE("SpectralPoissonSolver::backwardFFT");
+
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        AnyFFT::Execute(m_backward_line_plan[mfi]);
+
+        Box const& bx = mfi.validbox();
+        IntVect const lo = bx.smallEnd();
+        IntVect const len = bx.length();
+        Array4<Complex> const& field = m_spectral_transposed.array(mfi);
+        Complex const* const lines = m_spectral_lines[mfi].dataPtr();
+        ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            field(i, j, k) = lines[LineIndex(IntVect(AMREX_D_DECL(i, j, k)), lo, len)];
+        });
+    }
+
+    // Transpose back to the slabs split along the last direction
+    m_spectral_slabs.ParallelCopy(m_spectral_transposed);
+
+    for (MFIter mfi(m_real_field); mfi.isValid(); ++mfi) {
+        AnyFFT::Execute(m_backward_plan[mfi]);
+    }
+}
+
+void
+SpectralPoissonSolver::computeGreenFunction (Array<Real, AMREX_SPACEDIM> const& beta_solver)
+{
+    WARPX_PROFILE("SpectralPoissonSolver::computeGreenFunction");
+
+    // With open boundaries, the Green's function of the operator
+    // div((1 - beta beta^T) grad) is the one of the Laplacian in coordinates
+    // that are stretched by gamma along beta, which requires beta to be
+    // along one of the axes of the grid.
+    int n_moving_dims = 0;
+    GpuArray<double, AMREX_SPACEDIM> h;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (beta_solver[idim] != 0._rt) ++n_moving_dims;
+        h[idim] = m_geom.CellSize(idim) / std::sqrt(1. - beta_solver[idim]*beta_solver[idim]);
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(n_moving_dims <= 1,
+        "With open boundaries, the FFT Poisson solver requires the velocity "
+        "of the sources to be along one of the axes of the grid");
+
+    IntVect const fft_size = m_fft_size;
+    IntVect const lo = m_real_lo;
+    double const inv_n_points = 1./AMREX_D_TERM(double(fft_size[0]), *fft_size[1], *fft_size[2]);
+
+    for (MFIter mfi(m_real_field); mfi.isValid(); ++mfi) {
+        Array4<Real> const& green = m_real_field.array(mfi);
+
+        // Green's function of -rho/ep0, integrated over the cell around each node.
+        // The wrapped-around points correspond to negative separations.
+        ParallelFor(mfi.validbox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            IntVect const iv(AMREX_D_DECL(i, j, k));
+            GpuArray<double, AMREX_SPACEDIM> pos;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                int m = iv[idim] - lo[idim];
+                if (m >= fft_size[idim]/2) m -= fft_size[idim];
+                // the integrated Green's function is even in each direction
+                pos[idim] = std::abs(m) * h[idim];
+            }
+#if defined(WARPX_DIM_3D)
+            double const g = IntegratedInvR(pos, h) / (4.*MathConst::pi*PhysConst::ep0);
+#elif defined(WARPX_DIM_XZ)
+            double const g = -IntegratedLogR(pos, h) / (2.*MathConst::pi*PhysConst::ep0);
+#else
+            double const g = 0.;
+#endif
+            green(i, j, k) = static_cast<Real>(g * inv_n_points);
+        });
+    }
+
+    forwardFFT();
+
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        Complex const* const field = m_spectral_lines[mfi].dataPtr();
+        Complex* const green_hat = m_green_hat[mfi].dataPtr();
+        ParallelFor(m_spectral_lines[mfi].box().numPts(), [=] AMREX_GPU_DEVICE (Long n) noexcept
+        {
+            green_hat[n] = field[n];
+        });
+    }
+
+    m_green_beta = beta_solver;
+    m_green_defined = true;
+}
+
+void
+SpectralPoissonSolver::solve (MultiFab& phi, MultiFab const& rho, std::array<Real, 3> const& beta)
+{
+    WARPX_PROFILE("SpectralPoissonSolver::solve");
+
+    Array<Real, AMREX_SPACEDIM> const beta_solver =
+#if defined(WARPX_DIM_1D_Z)
+        {{ beta[2] }};
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        {{ beta[0], beta[2] }};
+#else
+        {{ beta[0], beta[1], beta[2] }};
+#endif
+
+    if (!m_is_periodic && (!m_green_defined || beta_solver != m_green_beta)) {
+        computeGreenFunction(beta_solver);
+    }
+
+    // Distribute rho on the FFT slabs (the padding, if any, stays at zero)
+    m_real_field.setVal(0._rt);
+    m_real_field.ParallelCopy(rho, 0, 0, 1);
+
+    forwardFFT();
+
+    IntVect const fft_size = m_fft_size;
+    GpuArray<Real, AMREX_SPACEDIM> const dx = m_geom.CellSizeArray();
+    Real const inv_n_points = static_cast<Real>(
+        1./AMREX_D_TERM(double(fft_size[0]), *fft_size[1], *fft_size[2]));
+
+    for (MFIter mfi(m_spectral_lines); mfi.isValid(); ++mfi) {
+        Box const& bx = mfi.validbox();
+        IntVect const lo = bx.smallEnd();
+        IntVect const len = bx.length();
+        Complex* const field = m_spectral_lines[mfi].dataPtr();
+        if (m_is_periodic) {
+            // Divide by the symbol of the finite-difference operator
+            // (the mean of rho, k=0, is discarded)
+            ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                IntVect const iv(AMREX_D_DECL(i, j, k));
+                Long const n = LineIndex(iv, lo, len);
+                Real K2[AMREX_SPACEDIM];
+                Real S[AMREX_SPACEDIM];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    Real const theta = 2._rt*MathConst::pi*iv[idim]/fft_size[idim];
+                    Real const K = 2._rt*std::sin(0.5_rt*theta)/dx[idim];
+                    K2[idim] = K*K;
+                    S[idim] = std::sin(theta)/dx[idim];
+                }
+                Real denom = 0._rt;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    denom += (1._rt - beta_solver[idim]*beta_solver[idim])*K2[idim];
+                    for (int jdim = 0; jdim < AMREX_SPACEDIM; ++jdim) {
+                        if (jdim != idim) denom -= beta_solver[idim]*beta_solver[jdim]*S[idim]*S[jdim];
+                    }
+                }
+                if (denom > 0._rt) {
+                    field[n] *= inv_n_points/(PhysConst::ep0*denom);
+                } else {
+                    field[n] = Complex{0._rt, 0._rt};
+                }
+            });
+        } else {
+            // Convolution with the Green's function (already normalized)
+            Complex const* const green_hat = m_green_hat[mfi].dataPtr();
+            ParallelFor(bx.numPts(), [=] AMREX_GPU_DEVICE (Long n) noexcept
+            {
+                field[n] *= green_hat[n];
+            });
+        }
+    }
+
+    backwardFFT();
+
+    // Scatter phi; for periodic domains, the last node is filled from the first one
+    phi.ParallelCopy(m_real_field, 0, 0, 1, IntVect(0), IntVect(0), m_geom.periodicity());
+    phi.FillBoundary(m_geom.periodicity());
+}
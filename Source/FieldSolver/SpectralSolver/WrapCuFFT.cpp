@@ -15,9 +15,11 @@ namespace AnyFFT
 #ifdef AMREX_USE_FLOAT
     cufftType VendorR2C = CUFFT_R2C;
     cufftType VendorC2R = CUFFT_C2R;
+    cufftType VendorC2C = CUFFT_C2C;
 #else
     cufftType VendorR2C = CUFFT_D2Z;
     cufftType VendorC2R = CUFFT_Z2D;
+    cufftType VendorC2C = CUFFT_Z2Z;
 #endif
 
     std::string cufftErrorToString (const cufftResult& err);
@@ -66,6 +68,44 @@ namespace AnyFFT
         return fft_plan;
     }
 
+    FFTplan CreateBatchedPlan(const amrex::IntVect& size, const int batch,
+                              amrex::Real * const real_array, Complex * const complex_array,
+                              const direction dir, const int dim)
+    {
+        FFTplan fft_plan;
+
+        if (dim < 1 || dim > AMREX_SPACEDIM) {
+            amrex::Abort(Utils::TextMsg::Err("dim must be between 1 and AMREX_SPACEDIM"));
+        }
+
+        // cuFFT is C-order: the slowest dimension comes first
+        int n[AMREX_SPACEDIM];
+        for (int idim = 0; idim < dim; ++idim) n[idim] = size[dim-1-idim];
+
+        cufftType type = VendorC2C;
+        if (dir == direction::R2C) type = VendorR2C;
+        else if (dir == direction::C2R) type = VendorC2R;
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // Without embedding, the arrays of the batch are contiguous.
+        cufftResult result = cufftPlanMany(
+            &(fft_plan.m_plan), dim, n, nullptr, 1, 0, nullptr, 1, 0, type, batch);
+
+        if ( result != CUFFT_SUCCESS ) {
+            amrex::Print() << Utils::TextMsg::Err(
+                    "cufftplan failed! Error: "
+                    + cufftErrorToString(result));
+        }
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+
     void DestroyPlan(FFTplan& fft_plan)
     {
         cufftDestroy( fft_plan.m_plan );
@@ -89,8 +129,15 @@ namespace AnyFFT
             result = cufftExecZ2D(fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array);
 #endif
         } else {
-            amrex::Abort(Utils::TextMsg::Err(
-                "direction must be AnyFFT::direction::R2C or AnyFFT::direction::C2R"));
+            int const vendor_dir = (fft_plan.m_dir == direction::C2C_FORWARD) ?
+                CUFFT_FORWARD : CUFFT_INVERSE;
+#ifdef AMREX_USE_FLOAT
+            result = cufftExecC2C(fft_plan.m_plan, fft_plan.m_complex_array,
+                                  fft_plan.m_complex_array, vendor_dir);
+#else
+            result = cufftExecZ2Z(fft_plan.m_plan, fft_plan.m_complex_array,
+                                  fft_plan.m_complex_array, vendor_dir);
+#endif
         }
         if ( result != CUFFT_SUCCESS ) {
             amrex::Print() << Utils::TextMsg::Err(
@@ -22,27 +22,40 @@ namespace AnyFFT
     const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftwf_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftwf_plan_many_dft_c2r;
+    const auto VendorCreatePlanManyC2C = fftwf_plan_many_dft;
 #else
     const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
     const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
     const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
     const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
+    const auto VendorCreatePlanManyR2C = fftw_plan_many_dft_r2c;
+    const auto VendorCreatePlanManyC2R = fftw_plan_many_dft_c2r;
+    const auto VendorCreatePlanManyC2C = fftw_plan_many_dft;
 #endif
 
-    FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
-    {
-        FFTplan fft_plan;
-
+    namespace {
+        void InitThreads ()
+        {
 #if defined(AMREX_USE_OMP) && defined(WarpX_FFTW_OMP)
 #   ifdef AMREX_USE_FLOAT
-        fftwf_init_threads();
-        fftwf_plan_with_nthreads(omp_get_max_threads());
+            fftwf_init_threads();
+            fftwf_plan_with_nthreads(omp_get_max_threads());
 #   else
-        fftw_init_threads();
-        fftw_plan_with_nthreads(omp_get_max_threads());
+            fftw_init_threads();
+            fftw_plan_with_nthreads(omp_get_max_threads());
 #   endif
 #endif
+        }
+    }
+
+    FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
+                       Complex * const complex_array, const direction dir, const int dim)
+    {
+        FFTplan fft_plan;
+
+        InitThreads();
 
         // Initialize fft_plan.m_plan with the vendor fft plan.
         // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
@@ -79,6 +92,55 @@ namespace AnyFFT
         return fft_plan;
     }
 
+    FFTplan CreateBatchedPlan(const amrex::IntVect& size, const int batch,
+                              amrex::Real * const real_array, Complex * const complex_array,
+                              const direction dir, const int dim)
+    {
+        FFTplan fft_plan;
+
+        InitThreads();
+
+        if (dim < 1 || dim > AMREX_SPACEDIM) {
+            amrex::Abort(Utils::TextMsg::Err(
+                "dim must be between 1 and AMREX_SPACEDIM"));
+        }
+
+        // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+        int n[AMREX_SPACEDIM];
+        int n_points = 1;
+        for (int idim = 0; idim < dim; ++idim) {
+            n[idim] = size[dim-1-idim];
+            n_points *= size[idim];
+        }
+        // number of complex points of each array of a R2C/C2R FFT
+        const int n_complex = n_points / size[0] * (size[0]/2 + 1);
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // The arrays of the batch are contiguous.
+        if (dir == direction::R2C){
+            fft_plan.m_plan = VendorCreatePlanManyR2C(
+                dim, n, batch, real_array, nullptr, 1, n_points,
+                complex_array, nullptr, 1, n_complex, FFTW_ESTIMATE);
+        } else if (dir == direction::C2R){
+            fft_plan.m_plan = VendorCreatePlanManyC2R(
+                dim, n, batch, complex_array, nullptr, 1, n_complex,
+                real_array, nullptr, 1, n_points, FFTW_ESTIMATE);
+        } else {
+            fft_plan.m_plan = VendorCreatePlanManyC2C(
+                dim, n, batch, complex_array, nullptr, 1, n_points,
+                complex_array, nullptr, 1, n_points,
+                (dir == direction::C2C_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD, FFTW_ESTIMATE);
+        }
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+
     void DestroyPlan(FFTplan& fft_plan)
     {
 #  ifdef AMREX_USE_FLOAT
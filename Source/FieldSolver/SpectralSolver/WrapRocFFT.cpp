@@ -58,6 +58,47 @@ namespace AnyFFT
         return fft_plan;
     }
 
+    FFTplan CreateBatchedPlan (const amrex::IntVect& size, const int batch,
+                               amrex::Real * const real_array, Complex * const complex_array,
+                               const direction dir, const int dim)
+    {
+        FFTplan fft_plan;
+
+        const std::size_t lengths[] = {AMREX_D_DECL(std::size_t(size[0]),
+                                                    std::size_t(size[1]),
+                                                    std::size_t(size[2]))};
+
+        rocfft_transform_type type = rocfft_transform_type_complex_forward;
+        if (dir == direction::R2C) type = rocfft_transform_type_real_forward;
+        else if (dir == direction::C2R) type = rocfft_transform_type_real_inverse;
+        else if (dir == direction::C2C_BACKWARD) type = rocfft_transform_type_complex_inverse;
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // Without description, the arrays of the batch are contiguous.
+        const bool is_c2c = (dir == direction::C2C_FORWARD || dir == direction::C2C_BACKWARD);
+        rocfft_status result = rocfft_plan_create(&(fft_plan.m_plan),
+                                                  is_c2c ? rocfft_placement_inplace
+                                                         : rocfft_placement_notinplace,
+                                                  type,
+#ifdef AMREX_USE_FLOAT
+                                                  rocfft_precision_single,
+#else
+                                                  rocfft_precision_double,
+#endif
+                                                  dim, lengths,
+                                                  batch, // number of transforms,
+                                                  nullptr);
+        assert_rocfft_status("rocfft_plan_create", result);
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+
     void DestroyPlan (FFTplan& fft_plan)
     {
         rocfft_plan_destroy( fft_plan.m_plan );
@@ -91,8 +132,11 @@ namespace AnyFFT
                                     (void**)&(fft_plan.m_real_array), // out
                                     execinfo);
         } else {
-            amrex::Abort(Utils::TextMsg::Err(
-                "direction must be AnyFFT::direction::R2C or AnyFFT::direction::C2R"));
+            // in place
+            result = rocfft_execute(fft_plan.m_plan,
+                                    (void**)&(fft_plan.m_complex_array), // in and out
+                                    nullptr,
+                                    execinfo);
         }
 
         assert_rocfft_status("rocfft_execute", result);
@@ -761,7 +761,16 @@ WarpX::PushPSATD ()
     {
         if (pml[lev] && pml[lev]->ok())
         {
-            pml[lev]->PushPSATD(lev);
+            // each patch is timed separately: its time goes to the costs of its own PML boxes
+            const amrex::Real wt = PMLCostsTimerStart(lev);
+            pml[lev]->PushPSATD(lev, PatchType::fine);
+            PMLCostsTimerStop(lev, PatchType::fine, wt);
+            if (lev > 0)
+            {
+                const amrex::Real wt_cp = PMLCostsTimerStart(lev);
+                pml[lev]->PushPSATD(lev, PatchType::coarse);
+                PMLCostsTimerStop(lev, PatchType::coarse, wt_cp);
+            }
         }
         ApplyEfieldBoundary(lev, PatchType::fine);
         if (lev > 0) ApplyEfieldBoundary(lev, PatchType::coarse);
@@ -807,13 +816,20 @@ WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
 
     // Evolve B field in PML cells
     if (do_pml && pml[lev]->ok()) {
+        // With fused damping, B is damped at the end of the second half push
+        // (instead of in DampPML)
+        const bool damp = pml_fused_damping && (a_dt_type == DtType::SecondHalf);
+        const amrex::Real wt = PMLCostsTimerStart(lev);
         if (patch_type == PatchType::fine) {
             m_fdtd_solver_fp[lev]->EvolveBPML(
-                pml[lev]->GetB_fp(), pml[lev]->GetE_fp(), a_dt, WarpX::do_dive_cleaning);
+                pml[lev]->GetB_fp(), pml[lev]->GetE_fp(), a_dt, WarpX::do_dive_cleaning,
+                damp ? &pml[lev]->GetMultiSigmaBox_fp() : nullptr, do_pml_divb_cleaning);
         } else {
             m_fdtd_solver_cp[lev]->EvolveBPML(
-                pml[lev]->GetB_cp(), pml[lev]->GetE_cp(), a_dt, WarpX::do_dive_cleaning);
+                pml[lev]->GetB_cp(), pml[lev]->GetE_cp(), a_dt, WarpX::do_dive_cleaning,
+                damp ? &pml[lev]->GetMultiSigmaBox_cp() : nullptr, do_pml_divb_cleaning);
         }
+        PMLCostsTimerStop(lev, patch_type, wt);
     }
 
     ApplyBfieldBoundary(lev, patch_type, a_dt_type);
@@ -858,21 +874,25 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 
     // Evolve E field in PML cells
     if (do_pml && pml[lev]->ok()) {
+        const amrex::Real wt = PMLCostsTimerStart(lev);
         if (patch_type == PatchType::fine) {
             m_fdtd_solver_fp[lev]->EvolveEPML(
                 pml[lev]->GetE_fp(), pml[lev]->GetB_fp(),
                 pml[lev]->Getj_fp(), pml[lev]->Get_edge_lengths(),
                 pml[lev]->GetF_fp(),
                 pml[lev]->GetMultiSigmaBox_fp(),
-                a_dt, pml_has_particles );
+                a_dt, pml_has_particles,
+                pml_fused_damping, do_pml_dive_cleaning );
         } else {
             m_fdtd_solver_cp[lev]->EvolveEPML(
                 pml[lev]->GetE_cp(), pml[lev]->GetB_cp(),
                 pml[lev]->Getj_cp(), pml[lev]->Get_edge_lengths(),
                 pml[lev]->GetF_cp(),
                 pml[lev]->GetMultiSigmaBox_cp(),
-                a_dt, pml_has_particles );
+                a_dt, pml_has_particles,
+                pml_fused_damping, do_pml_dive_cleaning );
         }
+        PMLCostsTimerStop(lev, patch_type, wt);
     }
 
     ApplyEfieldBoundary(lev, patch_type);
@@ -933,6 +953,7 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
 
     // Evolve F field in PML cells
     if (do_pml && pml[lev]->ok()) {
+        const amrex::Real wt = PMLCostsTimerStart(lev);
         if (patch_type == PatchType::fine) {
             m_fdtd_solver_fp[lev]->EvolveFPML(
                 pml[lev]->GetF_fp(), pml[lev]->GetE_fp(), a_dt );
@@ -940,6 +961,7 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
             m_fdtd_solver_cp[lev]->EvolveFPML(
                 pml[lev]->GetF_cp(), pml[lev]->GetE_cp(), a_dt );
         }
+        PMLCostsTimerStop(lev, patch_type, wt);
     }
 }
 
@@ -1022,21 +1044,25 @@ WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt) {
         a_dt, m_macroscopic_properties);
 
     if (do_pml && pml[lev]->ok()) {
+        const amrex::Real wt = PMLCostsTimerStart(lev);
         if (patch_type == PatchType::fine) {
             m_fdtd_solver_fp[lev]->EvolveEPML(
                 pml[lev]->GetE_fp(), pml[lev]->GetB_fp(),
                 pml[lev]->Getj_fp(), pml[lev]->Get_edge_lengths(),
                 pml[lev]->GetF_fp(),
                 pml[lev]->GetMultiSigmaBox_fp(),
-                a_dt, pml_has_particles );
+                a_dt, pml_has_particles,
+                pml_fused_damping, do_pml_dive_cleaning );
         } else {
             m_fdtd_solver_cp[lev]->EvolveEPML(
                 pml[lev]->GetE_cp(), pml[lev]->GetB_cp(),
                 pml[lev]->Getj_cp(), pml[lev]->Get_edge_lengths(),
                 pml[lev]->GetF_cp(),
                 pml[lev]->GetMultiSigmaBox_cp(),
-                a_dt, pml_has_particles );
+                a_dt, pml_has_particles,
+                pml_fused_damping, do_pml_dive_cleaning );
         }
+        PMLCostsTimerStop(lev, patch_type, wt);
     }
 
     ApplyEfieldBoundary(lev, patch_type);
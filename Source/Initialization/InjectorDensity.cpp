@@ -25,6 +25,7 @@ void InjectorDensity::clear ()
     switch (type)
     {
     case Type::parser:
+    case Type::separable:
     {
         break;
     }
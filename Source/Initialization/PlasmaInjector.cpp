@@ -369,6 +369,7 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
         num_particles_per_cell = num_particles_per_cell_each_dim[0] *
                                  num_particles_per_cell_each_dim[1] *
                                  num_particles_per_cell_each_dim[2];
+        regular_positions = true;
         parseDensity(pp_species_name);
         parseMomentum(pp_species_name);
     } else if (injection_style == "external_file") {
@@ -550,6 +551,20 @@ void PlasmaInjector::parseDensity (amrex::ParmParse& pp)
                                                               str_density_function,{"x","y","z"}));
         h_inj_rho.reset(new InjectorDensity((InjectorDensityParser*)nullptr,
                                             density_parser->compile<3>()));
+    } else if (rho_prof_s == "parse_separable_density_function") {
+        Store_parserString(pp, "density_function_transverse(x,y)",
+                           str_density_function_transverse);
+        Store_parserString(pp, "density_function_longitudinal(z)",
+                           str_density_function_longitudinal);
+        // Construct InjectorDensity with InjectorDensitySeparable.
+        density_transverse_parser = std::make_unique<amrex::Parser>(makeParser(
+                                        str_density_function_transverse,{"x","y"}));
+        density_longitudinal_parser = std::make_unique<amrex::Parser>(makeParser(
+                                          str_density_function_longitudinal,{"z"}));
+        h_inj_rho.reset(new InjectorDensity((InjectorDensitySeparable*)nullptr,
+                                            density_transverse_parser->compile<2>(),
+                                            density_longitudinal_parser->compile<1>()));
+        separable_density = true;
     } else {
         //No need for profile definition if external file is used
         std::string injection_style = "none";
@@ -8,6 +8,7 @@
  */
 #include "WarpX.H"
 
+#include "BoundaryConditions/PML.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "EmbeddedBoundary/WarpXFaceInfoBox.H"
@@ -24,6 +25,7 @@
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabFactory.H>
+#include <AMReX_GpuDevice.H>
 #include <AMReX_IArrayBox.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_LayoutData.H>
@@ -34,6 +36,7 @@
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
 
@@ -159,6 +162,9 @@ RemakeMultiFab (std::unique_ptr<MultiFabType>& mf, const DistributionMapping& dm
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
+    // the cached Poisson solvers refer to the old grids (and EB factories)
+    if (m_poisson_solver_cache) m_poisson_solver_cache->clear();
+
     if (ba == boxArray(lev))
     {
         if (ParallelDescriptor::NProcs() == 1) return;
@@ -194,6 +200,15 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
         // phi_fp should be redistributed since we use the solution from
         // the last step as the initial guess for the next solve
         RemakeMultiFab(phi_fp[lev], dm, true);
+        // so should the previous solutions used to extrapolate the guess
+        for (auto& phi_old : m_phi_history[lev]) {
+            RemakeMultiFab(phi_old, dm, true);
+        }
+
+        // PML boxes follow the grid boxes they are attached to
+        if (do_pml && pml[lev] && do_pml_load_balance) {
+            pml[lev]->Redistribute(dm, dt[lev]);
+        }
 
 #ifdef AMREX_USE_EB
         RemakeMultiFab(m_distance_to_eb[lev], dm, false);
@@ -347,6 +362,9 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
 void
 WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<amrex::Real> > >& a_costs)
 {
+    // the costs include the species whose restart was deferred, which are read now
+    mypc->LoadDeferredSpecies();
+
     for (int lev = 0; lev <= finest_level; ++lev)
     {
         const auto & mypc_ref = GetInstance().GetPartContainer();
@@ -371,6 +389,52 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
             const Box& gbx = mfi.growntilebox();
             (*a_costs[lev])[mfi.index()] += costs_heuristic_cells_wt*gbx.numPts();
         }
+
+#ifdef AMREX_USE_EB
+        // ECT: the extended faces borrow area from their neighbors at each B update
+        if (WarpX::maxwell_solver_id == MaxwellSolverAlgo::ECT)
+        {
+            for (int idim = 0; idim < 3; ++idim)
+            {
+                if (!m_borrowing[lev][idim]) continue;
+                for (MFIter mfi(*Bfield_fp[lev][idim], false); mfi.isValid(); ++mfi)
+                {
+                    const auto n_borrowed = (*m_borrowing[lev][idim])[mfi].inds.size();
+                    (*a_costs[lev])[mfi.index()] += costs_heuristic_cells_wt*n_borrowed;
+                }
+            }
+        }
+#endif
+
+        // PML cells, added to the grid boxes they are attached to
+        if (do_pml && pml[lev])
+        {
+            pml[lev]->AddCellCosts(*a_costs[lev], PatchType::fine, costs_heuristic_pml_cells_wt);
+            if (lev > 0) {
+                pml[lev]->AddCellCosts(*a_costs[lev], PatchType::coarse, costs_heuristic_pml_cells_wt);
+            }
+        }
+    }
+}
+
+amrex::Real
+WarpX::PMLCostsTimerStart (int lev) const
+{
+    if (costs[lev] && load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+    {
+        amrex::Gpu::synchronize();
+    }
+    return amrex::second();
+}
+
+void
+WarpX::PMLCostsTimerStop (int lev, PatchType patch_type, amrex::Real wt_start) const
+{
+    if (costs[lev] && load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+    {
+        amrex::Gpu::synchronize();
+        const amrex::Real wt = amrex::second() - wt_start;
+        pml[lev]->AddCosts(*costs[lev], patch_type, wt);
     }
 }
 
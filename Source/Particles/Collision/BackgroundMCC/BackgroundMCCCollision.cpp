@@ -6,6 +6,7 @@
  */
 #include "BackgroundMCCCollision.H"
 #include "ImpactIonization.H"
+#include "Particles/Collision/BinaryCollision/RandomPermutation.H"
 #include "Particles/ParticleCreation/FilterCopyTransform.H"
 #include "Particles/ParticleCreation/SmartCopy.H"
 #include "Utils/TextMsg.H"
@@ -14,12 +15,23 @@
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
+#include <AMReX_Array4.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_MultiFab.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Random.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
+#include <cstdint>
+#include <random>
+#include <set>
 #include <string>
 
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
 BackgroundMCCCollision::BackgroundMCCCollision (std::string const collision_name)
     : CollisionBase(collision_name)
 {
@@ -77,6 +89,29 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const collision_name
     m_background_mass = -1;
     queryWithParser(pp_collision_name, "background_mass", m_background_mass);
 
+    pp_collision_name.query("binomial_preselection", m_binomial_preselection);
+    if (m_binomial_preselection) {
+        // one host generator per OpenMP thread (the tiles are processed in parallel),
+        // seeded once from the AMReX random number generator
+#ifdef AMREX_USE_OMP
+        const int nthreads = omp_get_max_threads();
+#else
+        const int nthreads = 1;
+#endif
+        for (int i = 0; i < nthreads; ++i) {
+            m_preselection_generators.emplace_back(amrex::Random_int(0xffffffffu));
+        }
+    }
+    pp_collision_name.query("use_cross_section_table", m_use_cross_section_table);
+    pp_collision_name.query("precompute_background", m_precompute_background);
+    if (m_precompute_background) {
+        std::set<std::string> symbols = m_background_density_parser.symbols();
+        std::set<std::string> const T_symbols = m_background_temperature_parser.symbols();
+        symbols.insert(T_symbols.begin(), T_symbols.end());
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(symbols.count("t") == 0,
+            "precompute_background requires a time-independent background density and temperature");
+    }
+
     // query for a list of collision processes
     // these could be elastic, excitation, charge_exchange, back, etc.
     amrex::Vector<std::string> scattering_process_names;
@@ -147,6 +182,10 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const collision_name
         m_ionization_processes_exe.push_back(p.executor());
     }
 #endif
+
+    if (m_use_cross_section_table && !m_scattering_processes.empty()) {
+        m_cross_section_table.init(m_scattering_processes);
+    }
 }
 
 /** Calculate the maximum collision frequency using a fixed energy grid that
@@ -266,6 +305,8 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
 
         auto cost = WarpX::getCosts(lev);
 
+        if (m_precompute_background) computeBackgroundOnGrid(lev, species1);
+
         // firstly loop over particles box by box and do all particle conserving
         // scattering
         
@@ -298,6 +339,56 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
 }
 
 
+void BackgroundMCCCollision::computeBackgroundOnGrid
+( int lev, WarpXParticleContainer const& species1 )
+{
+    using namespace amrex::literals;
+
+    if (static_cast<int>(m_background_on_grid.size()) <= lev) {
+        m_background_on_grid.resize(lev+1);
+    }
+    auto& background = m_background_on_grid[lev];
+    const amrex::BoxArray& ba = species1.ParticleBoxArray(lev);
+    const amrex::DistributionMapping& dm = species1.ParticleDistributionMap(lev);
+    // nothing to do if the grids did not change (e.g. regrid or load balancing)
+    if (background && background->boxArray() == ba && background->DistributionMap() == dm) return;
+
+    background = std::make_unique<amrex::MultiFab>(ba, dm, 2, 0);
+
+    auto n_a_func = m_background_density_func;
+    auto T_a_func = m_background_temperature_func;
+    const auto plo = species1.Geom(lev).ProbLoArray();
+    const auto dx = species1.Geom(lev).CellSizeArray();
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for (amrex::MFIter mfi(*background, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        amrex::Array4<amrex::Real> const& bg = background->array(mfi);
+        amrex::ParallelFor(mfi.tilebox(), [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j, k);
+            // cell center, with the same conventions as GetParticlePosition::AsStored
+#if defined(WARPX_DIM_3D)
+            amrex::Real const x = plo[0] + (i + 0.5_rt)*dx[0];
+            amrex::Real const y = plo[1] + (j + 0.5_rt)*dx[1];
+            amrex::Real const z = plo[2] + (k + 0.5_rt)*dx[2];
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+            amrex::Real const x = plo[0] + (i + 0.5_rt)*dx[0];
+            amrex::Real const y = 0._rt;
+            amrex::Real const z = plo[1] + (j + 0.5_rt)*dx[1];
+#else
+            amrex::Real const x = 0._rt;
+            amrex::Real const y = 0._rt;
+            amrex::Real const z = plo[0] + (i + 0.5_rt)*dx[0];
+#endif
+            bg(i,j,k,0) = n_a_func(x, y, z, 0._rt);
+            bg(i,j,k,1) = T_a_func(x, y, z, 0._rt);
+        });
+    }
+}
+
+
 void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
 ( WarpXParIter& pti, amrex::Real t )
 {
@@ -321,6 +412,23 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     auto const total_collision_prob = m_total_collision_prob;
     auto const nu_max = m_nu_max;
 
+    // fused cross-section table of all processes, if requested
+    bool const use_table = m_use_cross_section_table && process_count > 0;
+    auto const table = m_cross_section_table.executor();
+
+    // background density and temperature on the grid, if precomputed
+    bool const use_grid = m_precompute_background;
+    amrex::Array4<amrex::Real const> background;
+    amrex::Box background_box;
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> plo, dxi;
+    if (use_grid) {
+        const int lev = pti.GetLevel();
+        background = m_background_on_grid[lev]->const_array(pti);
+        background_box = pti.validbox();
+        plo = WarpX::GetInstance().Geom(lev).ProbLoArray();
+        dxi = WarpX::GetInstance().Geom(lev).InvCellSizeArray();
+    }
+
     // store projectile and target masses
     auto const m = m_mass1;
     auto const M = m_background_mass;
@@ -339,17 +447,32 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     amrex::ParticleReal* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
     amrex::ParticleReal* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
 
-    amrex::ParallelForRNG(np,
-                          [=] AMREX_GPU_HOST_DEVICE (long ip, amrex::RandomEngine const& engine)
+    auto collide = [=] AMREX_GPU_HOST_DEVICE (long ip, amrex::RandomEngine const& engine)
                           {
-                              // determine if this particle should collide
-                              if (amrex::Random(engine) > total_collision_prob) return;
-
                               amrex::ParticleReal x, y, z;
                               GetPosition.AsStored(ip, x, y, z);
 
-                              amrex::ParticleReal n_a = n_a_func(x, y, z, t);
-                              amrex::ParticleReal T_a = T_a_func(x, y, z, t);
+                              amrex::ParticleReal n_a, T_a;
+                              if (use_grid) {
+                                  amrex::ignore_unused(y);
+#if defined(WARPX_DIM_3D)
+                                  amrex::IntVect iv(static_cast<int>(amrex::Math::floor((x-plo[0])*dxi[0])),
+                                                    static_cast<int>(amrex::Math::floor((y-plo[1])*dxi[1])),
+                                                    static_cast<int>(amrex::Math::floor((z-plo[2])*dxi[2])));
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+                                  amrex::IntVect iv(static_cast<int>(amrex::Math::floor((x-plo[0])*dxi[0])),
+                                                    static_cast<int>(amrex::Math::floor((z-plo[1])*dxi[1])));
+#else
+                                  amrex::IntVect iv(static_cast<int>(amrex::Math::floor((z-plo[0])*dxi[0])));
+#endif
+                                  iv.max(background_box.smallEnd());
+                                  iv.min(background_box.bigEnd());
+                                  n_a = background(iv, 0);
+                                  T_a = background(iv, 1);
+                              } else {
+                                  n_a = n_a_func(x, y, z, t);
+                                  T_a = T_a_func(x, y, z, t);
+                              }
 
                               amrex::ParticleReal v_coll, v_coll2, sigma_E, nu_i = 0;
                               double gamma, E_coll;
@@ -378,15 +501,27 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               // calculate the collision energy in eV
                               ParticleUtils::getCollisionEnergy(v_coll2, m, M, gamma, E_coll);
 
+                              // with the fused table, a single interpolation point gives
+                              // the cumulative cross-section of all the processes
+                              int table_idx = 0;
+                              amrex::ParticleReal table_frac = 0;
+                              if (use_table) table.getInterpolationPoint(E_coll, table_idx, table_frac);
+
                               // loop through all collision pathways
                               for (int i = 0; i < process_count; i++) {
                                   auto const& scattering_process = *(scattering_processes + i);
 
-                                  // get collision cross-section
-                                  sigma_E = scattering_process.getCrossSection(E_coll);
+                                  if (use_table) {
+                                      // cumulative normalized collision frequency of processes 0 to i
+                                      nu_i = n_a * v_coll / nu_max
+                                          * table.getCumulativeCrossSection(table_idx, table_frac, i);
+                                  } else {
+                                      // get collision cross-section
+                                      sigma_E = scattering_process.getCrossSection(E_coll);
 
-                                  // calculate normalized collision frequency
-                                  nu_i += n_a * sigma_E * v_coll / nu_max;
+                                      // calculate normalized collision frequency
+                                      nu_i += n_a * sigma_E * v_coll / nu_max;
+                                  }
 
                                   // check if this collision should be performed
                                   if (col_select > nu_i) continue;
@@ -445,8 +580,40 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                                   uz[ip] = vz + ua_z;
                                   break;
                               }
-                          }
-                          );
+                          };
+
+    if (m_binomial_preselection) {
+        // Each particle collides independently with probability total_collision_prob,
+        // i.e. the number of colliding particles follows a binomial distribution and
+        // they form a uniformly random subset of the tile: draw this number on the host,
+        // then select the colliding particles as the first elements of a random
+        // permutation of the tile, so that only the colliding particles are visited.
+#ifdef AMREX_USE_OMP
+        const int thread_num = omp_get_thread_num();
+#else
+        const int thread_num = 0;
+#endif
+        std::mt19937& generator = m_preselection_generators[thread_num];
+        std::binomial_distribution<long> binomial(np, total_collision_prob);
+        const long n_coll = (np > 0) ? binomial(generator) : 0;
+        const auto perm = RandomPermutation(static_cast<std::uint32_t>(np),
+                                            static_cast<std::uint32_t>(generator()));
+        amrex::ParallelForRNG(n_coll,
+                              [=] AMREX_GPU_HOST_DEVICE (long i, amrex::RandomEngine const& engine)
+                              {
+                                  collide(perm(static_cast<std::uint32_t>(i)), engine);
+                              }
+                              );
+    } else {
+        amrex::ParallelForRNG(np,
+                              [=] AMREX_GPU_HOST_DEVICE (long ip, amrex::RandomEngine const& engine)
+                              {
+                                  // determine if this particle should collide
+                                  if (amrex::Random(engine) > total_collision_prob) return;
+                                  collide(ip, engine);
+                              }
+                              );
+    }
 }
 
 
@@ -0,0 +1,80 @@
+/* Copyright 2022 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "MCCCrossSectionTable.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuDevice.H>
+#include <AMReX.H>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+    /** Maximum number of entries (energies times processes) of the table:
+     *  2^24 entries, i.e. 128 MB in double precision, on each MPI rank and GPU */
+    constexpr double max_table_entries = 16777216.;
+}
+
+void
+MCCCrossSectionTable::init (amrex::Vector<MCCProcess> const& mcc_processes)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!mcc_processes.empty(),
+        "Cannot tabulate the cross-sections of an empty list of MCC processes");
+
+    // common energy grid: union of the input energy ranges, finest input step
+    amrex::ParticleReal E_lo = mcc_processes[0].getMinEnergyInput();
+    amrex::ParticleReal E_hi = mcc_processes[0].getMaxEnergyInput();
+    amrex::ParticleReal dE = mcc_processes[0].getEnergyInputStep();
+    for (auto const& process : mcc_processes) {
+        E_lo = std::min(E_lo, process.getMinEnergyInput());
+        E_hi = std::max(E_hi, process.getMaxEnergyInput());
+        dE = std::min(dE, process.getEnergyInputStep());
+    }
+    const int n_processes = mcc_processes.size();
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(dE > 0.0,
+        "The energy steps of the MCC cross-section files must be positive");
+    // computed in double precision, since it can overflow an int for large ranges or fine steps
+    const double n_energies_d = std::max(2., std::ceil(static_cast<double>(E_hi - E_lo)/dE) + 1.);
+    if (n_energies_d*n_processes > max_table_entries) {
+        std::ostringstream msg;
+        msg << "The common energy grid of the MCC cross-sections (from " << E_lo << " to " << E_hi
+            << " eV, with the finest input step " << dE << " eV) would have "
+            << static_cast<long>(n_energies_d) << " energies for " << n_processes
+            << " processes, more than the " << static_cast<long>(max_table_entries)
+            << " table entries allowed: use cross-section files with coarser energy steps";
+        amrex::Abort(Utils::TextMsg::Err(msg.str()));
+    }
+    const int n_energies = static_cast<int>(n_energies_d);
+
+    m_data_h.resize(n_energies*n_processes);
+    for (int i = 0; i < n_energies; ++i) {
+        const amrex::ParticleReal E = E_lo + i*dE;
+        amrex::ParticleReal sigma = 0.0;
+        for (int p = 0; p < n_processes; ++p) {
+            sigma += mcc_processes[p].getCrossSection(E);
+            m_data_h[i*n_processes + p] = sigma;
+        }
+    }
+
+    m_exe_h.m_data = m_data_h.data();
+    m_exe_h.m_energy_lo = E_lo;
+    m_exe_h.m_inv_dE = amrex::ParticleReal(1.0)/dE;
+    m_exe_h.m_n_energies = n_energies;
+    m_exe_h.m_n_processes = n_processes;
+
+#ifdef AMREX_USE_GPU
+    m_exe_d = m_exe_h;
+    m_data_d.resize(m_data_h.size());
+    m_exe_d.m_data = m_data_d.data();
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_data_h.begin(), m_data_h.end(),
+                          m_data_d.begin());
+    amrex::Gpu::streamSynchronize();
+#endif
+}
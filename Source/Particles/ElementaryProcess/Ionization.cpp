@@ -30,7 +30,9 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_power,
                                             int a_comp,
                                             int a_atomic_number,
-                                            int a_offset) noexcept
+                                            int a_offset,
+                                            amrex::ParticleReal* a_cached_fields,
+                                            ADKRateTable const& a_rate_table) noexcept
 {
 
     using namespace amrex::literals;
@@ -74,4 +76,9 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
     m_n_rz_azimuthal_modes = WarpX::n_rz_azimuthal_modes;
 
     m_lo = amrex::lbound(box);
+
+    m_cached_fields = a_cached_fields;
+    m_cache_stride = a_pti.numParticles();
+
+    m_rate_table = a_rate_table;
 }
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <initializer_list>
 #include <iosfwd>
 #include <vector>
@@ -65,15 +66,27 @@ QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
     const vector<char>& raw_data,
     const amrex::ParticleReal qs_minimum_chi_part)
 {
-    auto raw_iter = raw_data.begin();
-    const auto size_first = pxr_sr::get_out<uint64_t>(raw_iter);
-    if(size_first <= 0 || size_first >= raw_data.size() ) return false;
+    return init_lookup_tables_from_raw_data(
+        raw_data.data(), raw_data.data() + raw_data.size(), qs_minimum_chi_part);
+}
+
+bool
+QuantumSynchrotronEngine::init_lookup_tables_from_raw_data (
+    const char* raw_begin, const char* raw_end,
+    const amrex::ParticleReal qs_minimum_chi_part)
+{
+    const auto raw_size = static_cast<uint64_t>(raw_end - raw_begin);
+    uint64_t size_first = 0;
+    if(raw_size < sizeof(size_first)) return false;
+    std::memcpy(&size_first, raw_begin, sizeof(size_first));
+    const char* raw_iter = raw_begin + sizeof(size_first);
+    if(size_first <= 0 || size_first >= raw_size ) return false;
 
     const auto raw_dndt_table = vector<char>{
         raw_iter, raw_iter+size_first};
 
     const auto raw_phot_em_table = vector<char>{
-        raw_iter+size_first, raw_data.end()};
+        raw_iter+size_first, raw_end};
 
     m_dndt_table = QS_dndt_table{raw_dndt_table};
     m_phot_em_table = QS_phot_em_table{raw_phot_em_table};
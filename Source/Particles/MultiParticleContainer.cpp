@@ -34,6 +34,7 @@
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #ifdef AMREX_USE_EB
 #   include "EmbeddedBoundary/ParticleScraper.H"
 #   include "EmbeddedBoundary/ParticleBoundaryProcess.H"
@@ -70,8 +71,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -480,6 +483,7 @@ MultiParticleContainer::Evolve (int lev,
     for (auto& pc : allcontainers) {
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition);
+        pc->invalidateCellBins();
     }
 }
 
@@ -611,6 +615,7 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
     for (auto& pc : allcontainers) {
         pc->SortParticlesByBin(bin_size);
+        pc->invalidateCellBins();
     }
 }
 
@@ -619,6 +624,7 @@ MultiParticleContainer::Redistribute ()
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute();
+        pc->invalidateCellBins();
     }
 }
 
@@ -635,6 +641,7 @@ MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
+        pc->invalidateCellBins();
     }
 }
 
@@ -1104,11 +1111,7 @@ void MultiParticleContainer::InitQuantumSync ()
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Quantum Synchrotron table will be generated.",
             ablastr::warn_manager::WarnPriority::low);
-#ifndef WARPX_QED_TABLE_GEN
-        amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
         QuantumSyncGenerateTable();
-#endif
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1119,10 +1122,9 @@ void MultiParticleContainer::InitQuantumSync ()
         if(load_table_name.empty()){
             amrex::Abort("Quantum Synchrotron table name should be provided");
         }
-        Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
-        ParallelDescriptor::Barrier();
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(table_data,
+        const WarpXUtilIO::NodeSharedFileData table_data(load_table_name);
+        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
+            table_data.data(), table_data.data() + table_data.size(),
             qs_minimum_chi_part);
     }
     else if(lookup_table_mode == "builtin"){
@@ -1162,11 +1164,7 @@ void MultiParticleContainer::InitBreitWheeler ()
         ablastr::warn_manager::WMRecordWarning("QED",
             "A new Breit Wheeler table will be generated.",
             ablastr::warn_manager::WarnPriority::low);
-#ifndef WARPX_QED_TABLE_GEN
-        amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
         BreitWheelerGenerateTable();
-#endif
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1177,11 +1175,10 @@ void MultiParticleContainer::InitBreitWheeler ()
         if(load_table_name.empty()){
             amrex::Abort("Breit Wheeler table name should be provided");
         }
-        Vector<char> table_data;
-        ParallelDescriptor::ReadAndBcastFile(load_table_name, table_data);
-        ParallelDescriptor::Barrier();
+        const WarpXUtilIO::NodeSharedFileData table_data(load_table_name);
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
+            table_data.data(), table_data.data() + table_data.size(),
+            bw_minimum_chi_part);
     }
     else if(lookup_table_mode == "builtin"){
         ablastr::warn_manager::WMRecordWarning("QED",
@@ -1199,13 +1196,74 @@ void MultiParticleContainer::InitBreitWheeler ()
     }
 }
 
+namespace
+{
+    /**
+     * Initialize the lookup tables of a QED engine from the table cache if it holds a
+     * table generated with the same parameters, or generate the table (on the I/O
+     * processor) and save it. All the ranks then read the table, stored once per node.
+     */
+    template <typename Engine, typename Ctrl>
+    void QEDReadOrGenerateTable (Engine& engine, Ctrl const& ctrl,
+                                 const amrex::Real minimum_chi,
+                                 std::string const& process_name,
+                                 std::string const& cache_prefix,
+                                 std::string const& table_name,
+                                 std::string const& cache_dir,
+                                 std::string const& key)
+    {
+        const std::string cached_name = cache_dir.empty() ? std::string() :
+            WarpXUtilIO::CachedFileName(cache_dir, cache_prefix, key);
+        const bool use_cache = !cached_name.empty() &&
+            WarpXUtilIO::IsCachedFileValid(cached_name, key);
+
+        if (use_cache) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "The " + process_name + " table will be read from the cache: " + cached_name,
+                ablastr::warn_manager::WarnPriority::low);
+        } else {
+#ifndef WARPX_QED_TABLE_GEN
+            amrex::ignore_unused(engine, ctrl, minimum_chi);
+            amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
+#else
+            if(ParallelDescriptor::IOProcessor()){
+                engine.compute_lookup_tables(ctrl, minimum_chi);
+                const auto data = engine.export_lookup_tables_data();
+                const auto table_data = Vector<char>{data.begin(), data.end()};
+                if (!table_name.empty())
+                    WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+                if (!cached_name.empty())
+                    WarpXUtilIO::WriteCachedFile(cached_name, key, table_data);
+            }
+#endif
+        }
+        ParallelDescriptor::Barrier();
+
+        const WarpXUtilIO::NodeSharedFileData table_data(
+            (use_cache || table_name.empty()) ? cached_name : table_name);
+
+        //No need to initialize from raw data for the processor that
+        //has just generated the table
+        if(use_cache || !ParallelDescriptor::IOProcessor()){
+            engine.init_lookup_tables_from_raw_data(
+                table_data.data(), table_data.data() + table_data.size(), minimum_chi);
+        }
+        if(use_cache && !table_name.empty() && ParallelDescriptor::IOProcessor()){
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name,
+                Vector<char>{table_data.data(), table_data.data() + table_data.size()});
+        }
+    }
+}
+
 void
 MultiParticleContainer::QuantumSyncGenerateTable ()
 {
     ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
-    if(table_name.empty())
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
+    if(table_name.empty() && cache_dir.empty())
         amrex::Abort("qed_qs.save_table_in should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
@@ -1214,70 +1272,69 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
-
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
-
-        //This parameter is the number of different points to consider for the second
-        //axis
-        getWithParser(pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
-
-        m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
-        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
-    }
-
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
-
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
-            table_data, qs_minimum_chi_part);
-    }
+    PicsarQuantumSyncCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+
+    //This parameter is the number of different points to consider for the second
+    //axis
+    getWithParser(pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
+
+    // The table only depends on these parameters (and on the precision):
+    // if it was already generated with them, it is read from the cache
+    std::ostringstream key;
+    key << std::setprecision(17) << "quantum_sync"
+        << " sizeof_particle_real=" << sizeof(amrex::ParticleReal)
+        << " dndt=" << ctrl.dndt_params.chi_part_min
+        << "," << ctrl.dndt_params.chi_part_max
+        << "," << ctrl.dndt_params.chi_part_how_many
+        << " em=" << ctrl.phot_em_params.chi_part_min
+        << "," << ctrl.phot_em_params.chi_part_max
+        << "," << ctrl.phot_em_params.chi_part_how_many
+        << "," << ctrl.phot_em_params.frac_min
+        << "," << ctrl.phot_em_params.frac_how_many;
+
+    QEDReadOrGenerateTable(*m_shr_p_qs_engine, ctrl, qs_minimum_chi_part,
+                           "Quantum Synchrotron", "qed_qs_table",
+                           table_name, cache_dir, key.str());
 }
 
 void
@@ -1286,7 +1343,9 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
-    if(table_name.empty())
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
+    if(table_name.empty() && cache_dir.empty())
         amrex::Abort("qed_bw.save_table_in should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
@@ -1295,66 +1354,64 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        getWithParser(pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        getWithParser(pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
-
-        m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
-        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
-    }
-
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
-
-    //No need to initialize from raw data for the processor that
-    //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
-        m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
-            table_data, bw_minimum_chi_part);
-    }
+    PicsarBreitWheelerCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    getWithParser(pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    getWithParser(pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
+
+    // The table only depends on these parameters (and on the precision):
+    // if it was already generated with them, it is read from the cache
+    std::ostringstream key;
+    key << std::setprecision(17) << "breit_wheeler"
+        << " sizeof_particle_real=" << sizeof(amrex::ParticleReal)
+        << " dndt=" << ctrl.dndt_params.chi_phot_min
+        << "," << ctrl.dndt_params.chi_phot_max
+        << "," << ctrl.dndt_params.chi_phot_how_many
+        << " pair=" << ctrl.pair_prod_params.chi_phot_min
+        << "," << ctrl.pair_prod_params.chi_phot_max
+        << "," << ctrl.pair_prod_params.chi_phot_how_many
+        << "," << ctrl.pair_prod_params.frac_how_many;
+
+    QEDReadOrGenerateTable(*m_shr_p_bw_engine, ctrl, bw_minimum_chi_part,
+                           "Breit Wheeler", "qed_bw_table",
+                           table_name, cache_dir, key.str());
 }
 
 void
@@ -98,6 +98,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <limits>
 #include <map>
@@ -254,8 +255,20 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp_species_name.query("do_not_deposit", do_not_deposit);
     pp_species_name.query("do_not_gather", do_not_gather);
     pp_species_name.query("do_not_push", do_not_push);
+    pp_species_name.query("restart_deferred", restart_deferred);
 
     pp_species_name.query("do_continuous_injection", do_continuous_injection);
+    pp_species_name.query("injection_template", m_use_injection_template);
+    if (m_use_injection_template) {
+#ifdef WARPX_DIM_RZ
+        amrex::Abort(Utils::TextMsg::Err(
+            species_name + ".injection_template is not supported in RZ geometry"));
+#endif
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            plasma_injector->separable_density && plasma_injector->regular_positions,
+            species_name + ".injection_template requires "
+            "profile = parse_separable_density_function and injection_style = NUniformPerCell");
+    }
     pp_species_name.query("initialize_self_fields", initialize_self_fields);
     queryWithParser(pp_species_name, "self_fields_required_precision", self_fields_required_precision);
     queryWithParser(pp_species_name, "self_fields_absolute_tolerance", self_fields_absolute_tolerance);
@@ -266,6 +279,7 @@ PhysicalParticleContainer::PhysicalParticleContainer (AmrCore* amr_core, int isp
     pp_species_name.query("do_back_transformed_diagnostics", do_back_transformed_diagnostics);
 
     pp_species_name.query("do_field_ionization", do_field_ionization);
+    pp_species_name.query("cache_gathered_fields", m_cache_gathered_fields);
 
     pp_species_name.query("do_resampling", do_resampling);
     if (do_resampling) m_resampler = Resampling(species_name);
@@ -884,6 +898,11 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         fine_injection_box.coarsen(rrfac);
     }
 
+    // The injection templates rely on the transverse pattern of the
+    // particles being the same in every cell along the moving direction
+    const bool use_injection_template = m_use_injection_template && !refine_injection
+        && WarpX::moving_window_dir == AMREX_SPACEDIM-1;
+
     InjectorPosition* inj_pos = plasma_injector->getInjectorPosition();
     InjectorDensity*  inj_rho = plasma_injector->getInjectorDensity();
     InjectorMomentum* inj_mom = plasma_injector->getInjectorMomentum();
@@ -967,9 +986,28 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         if (refine_injection) {
             fine_overlap_box = overlap_box & amrex::shift(fine_injection_box, -shifted);
         }
+        // With a density separable along the moving direction, the transverse
+        // density of the particles is taken from the injection template of
+        // the tile, which is the same for every slab injected by the moving window.
+        // Transverse cells with zero density get no particles.
+        Real const* p_template_density = nullptr;
+        int const* p_template_active = nullptr;
+        Box template_box;
+        if (use_injection_template) {
+            auto const& entry = getInjectionTemplate(lev, std::make_pair(grid_id,tile_id),
+                                                     overlap_box, overlap_corner);
+            p_template_density = entry.density.dataPtr();
+            if (density_min > 0._rt) p_template_active = entry.active.dataPtr();
+            template_box = entry.box;
+        }
         amrex::ParallelFor(overlap_box, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
             IntVect iv(AMREX_D_DECL(i, j, k));
+            if (p_template_active) {
+                IntVect iv_t = iv;
+                iv_t[AMREX_SPACEDIM-1] = 0;
+                if (p_template_active[template_box.index(iv_t)] == 0) return;
+            }
             auto lo = getCellCoords(overlap_corner, dx, {0._rt, 0._rt, 0._rt}, iv);
             auto hi = getCellCoords(overlap_corner, dx, {1._rt, 1._rt, 1._rt}, iv);
 
@@ -1101,6 +1139,9 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         {
             IntVect iv = IntVect(AMREX_D_DECL(i, j, k));
             const auto index = overlap_box.index(iv);
+            IntVect iv_t = iv;
+            iv_t[AMREX_SPACEDIM-1] = 0;
+            const auto template_offset = template_box.index(iv_t)*num_ppc;
 #ifdef WARPX_DIM_RZ
             Real theta_offset = 0._rt;
             if (rz_random_theta) theta_offset = amrex::Random(engine) * 2._rt * MathConst::pi;
@@ -1204,7 +1245,12 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                     }
 
                     u = inj_mom->getMomentum(pos.x, pos.y, z0, engine);
-                    dens = inj_rho->getDensity(pos.x, pos.y, z0);
+                    if (p_template_density) {
+                        dens = p_template_density[template_offset + i_part]
+                            * inj_rho->getLongitudinalDensity(z0);
+                    } else {
+                        dens = inj_rho->getDensity(pos.x, pos.y, z0);
+                    }
 
                     // Remove particle if density below threshold
                     if ( dens < density_min ){
@@ -1235,7 +1281,12 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
                         continue;
                     }
                     // call `getDensity` with lab-frame parameters
-                    dens = inj_rho->getDensity(pos.x, pos.y, z0_lab);
+                    if (p_template_density) {
+                        dens = p_template_density[template_offset + i_part]
+                            * inj_rho->getLongitudinalDensity(z0_lab);
+                    } else {
+                        dens = inj_rho->getDensity(pos.x, pos.y, z0_lab);
+                    }
                     // Remove particle if density below threshold
                     if ( dens < density_min ){
                         ZeroInitializeAndSetNegativeID(p, pa, ip, loc_do_field_ionization, pi
@@ -1330,6 +1381,74 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
     // The function that calls this is responsible for redistributing particles.
 }
 
+PhysicalParticleContainer::InjectionTemplateEntry const&
+PhysicalParticleContainer::getInjectionTemplate (
+    int lev, PairIndex const& index, amrex::Box const& overlap_box,
+    amrex::GpuArray<amrex::Real,AMREX_SPACEDIM> const& overlap_corner)
+{
+    // Only the transverse extent of the injected cells matters
+    Box template_box = overlap_box;
+    template_box.setSmall(AMREX_SPACEDIM-1, 0);
+    template_box.setBig(AMREX_SPACEDIM-1, 0);
+
+    InjectionTemplateEntry* entry;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (injection_template)
+#endif
+    {
+        if (m_injection_templates.size() <= static_cast<std::size_t>(lev)) {
+            m_injection_templates.resize(lev+1);
+        }
+        entry = &m_injection_templates[lev][index];
+    }
+
+    bool valid = (entry->box == template_box);
+    for (int idim = 0; idim < AMREX_SPACEDIM-1; ++idim) {
+        valid = valid && (entry->corner[idim] == overlap_corner[idim]);
+    }
+    if (valid) return *entry;
+
+    WARPX_PROFILE("PhysicalParticleContainer::getInjectionTemplate()");
+
+    const int num_ppc = plasma_injector->num_particles_per_cell;
+    const auto dx = Geom(lev).CellSizeArray();
+    InjectorPosition* inj_pos = plasma_injector->getInjectorPosition();
+    InjectorDensity*  inj_rho = plasma_injector->getInjectorDensity();
+
+    entry->box = template_box;
+    entry->corner = overlap_corner;
+    entry->density.resize(template_box.numPts()*num_ppc);
+    entry->active.resize(template_box.numPts());
+    Real* pdensity = entry->density.dataPtr();
+    int* pactive = entry->active.dataPtr();
+
+    // The positions are regular (see getPositionUnitBox), so that the engine is not used
+    amrex::ParallelForRNG(template_box,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept
+    {
+        const IntVect iv(AMREX_D_DECL(i, j, k));
+        const auto cell = template_box.index(iv);
+        int active = 0;
+        for (int i_part = 0; i_part < num_ppc; ++i_part) {
+            const XDim3 r = inj_pos->getPositionUnitBox(i_part, 1, engine);
+            const auto pos = getCellCoords(overlap_corner, dx, r, iv);
+            const Real dens = inj_rho->getTransverseDensity(pos.x, pos.y);
+            pdensity[cell*num_ppc + i_part] = dens;
+            if (dens != 0._rt) active = 1;
+        }
+        pactive[cell] = active;
+#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+        amrex::ignore_unused(k);
+#endif
+#if defined(WARPX_DIM_1D_Z)
+        amrex::ignore_unused(j,k);
+#endif
+    });
+    amrex::Gpu::synchronize();
+
+    return *entry;
+}
+
 void
 PhysicalParticleContainer::AddPlasmaFlux (amrex::Real dt)
 {
@@ -2359,6 +2478,10 @@ PhysicalParticleContainer::Evolve (int lev,
 
     bool has_buffer = cEx || cjx;
 
+    // Particles in the buffers are reordered before the push, so that the
+    // fields cached by the ionization filter cannot be matched to them anymore
+    if (has_buffer) clearGatheredFieldsCache(lev);
+
     if ( (WarpX::do_back_transformed_diagnostics && do_back_transformed_diagnostics) ||
          (m_do_back_transformed_particles) )
     {
@@ -2572,6 +2695,9 @@ PhysicalParticleContainer::Evolve (int lev,
             }
         }
     }
+    // The cached fields are only valid for the positions before the push
+    clearGatheredFieldsCache(lev);
+
     // Split particles at the end of the timestep.
     // When subcycling is ON, the splitting is done on the last call to
     // PhysicalParticleContainer::Evolve on the finest level, i.e., at the
@@ -3332,6 +3458,14 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
 
     const auto t_do_not_gather = do_not_gather;
 
+    // Fields already gathered during this step by the ionization filter, if any
+    amrex::ParticleReal const* cached_fields = nullptr;
+    long cache_stride = 0;
+    long np_cached = 0;
+    if (useGatheredFieldsCache() && offset == 0 && gather_lev == lev) {
+        np_cached = findGatheredFieldsCache(lev, pti, cached_fields, cache_stride);
+    }
+
     amrex::ParallelFor( np_to_push, [=] AMREX_GPU_DEVICE (long ip)
     {
         amrex::ParticleReal xp, yp, zp;
@@ -3350,7 +3484,14 @@ PhysicalParticleContainer::PushPX (WarpXParIter& pti,
         amrex::ParticleReal Exp = 0._rt, Eyp = 0._rt, Ezp = 0._rt;
         amrex::ParticleReal Bxp = 0._rt, Byp = 0._rt, Bzp = 0._rt;
 
-        if(!t_do_not_gather){
+        if (ip < np_cached) {
+            Exp = cached_fields[ip                 ];
+            Eyp = cached_fields[ip +   cache_stride];
+            Ezp = cached_fields[ip + 2*cache_stride];
+            Bxp = cached_fields[ip + 3*cache_stride];
+            Byp = cached_fields[ip + 4*cache_stride];
+            Bzp = cached_fields[ip + 5*cache_stride];
+        } else if(!t_do_not_gather){
             // first gather E and B to the particle positions
             doGatherShapeN(xp, yp, zp, Exp, Eyp, Ezp, Bxp, Byp, Bzp,
                            ex_arr, ey_arr, ez_arr, bx_arr, by_arr, bz_arr,
@@ -3449,6 +3590,81 @@ PhysicalParticleContainer::InitIonizationModule ()
     });
 
     Gpu::synchronize();
+
+    pp_species_name.query("ionization_table_size", ionization_table_size);
+    queryWithParser(pp_species_name, "ionization_min_probability", ionization_min_probability);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ionization_table_size == 0 || ionization_table_size >= 2,
+        species_name + ".ionization_table_size must be 0 or at least 2");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ionization_min_probability >= 0._rt && ionization_min_probability < 1._rt,
+        species_name + ".ionization_min_probability must be in [0, 1)");
+    if (ionization_table_size > 0 || ionization_min_probability > 0._rt) {
+        InitIonizationRateTable();
+    }
+}
+
+void
+PhysicalParticleContainer::InitIonizationRateTable ()
+{
+    // The rate without the 1/gamma factor, w(E) = prefactor * E^power * exp(exp_prefactor/E),
+    // increases with E up to E_peak = exp_prefactor/power, and is an upper bound of
+    // the actual rate. Below E_min, where w(E) < w_min, particles are skipped.
+    // When no threshold is given, E_min is only used as the lower end of the tables,
+    // at a probability that cannot be resolved by the random draw anyway.
+    const int nlev = ion_atomic_number;
+    const int ntab = ionization_table_size;
+    const double w_min = (ionization_min_probability > 0._rt) ?
+        -std::log1p(-static_cast<double>(ionization_min_probability)) : 1.e-20;
+
+    Vector<Real> h_power(nlev), h_prefactor(nlev), h_exp_prefactor(nlev);
+    Gpu::copyAsync(Gpu::deviceToHost, adk_power.begin(), adk_power.end(), h_power.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, adk_prefactor.begin(), adk_prefactor.end(), h_prefactor.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, adk_exp_prefactor.begin(), adk_exp_prefactor.end(),
+                   h_exp_prefactor.begin());
+    Gpu::streamSynchronize();
+
+    Vector<Real> h_E_min(nlev), h_E_max(nlev), h_ln_E_min(nlev), h_inv_dln_E(nlev);
+    Vector<Real> h_ln_rate(static_cast<std::size_t>(nlev)*ntab);
+    for (int l = 0; l < nlev; ++l) {
+        const double power = h_power[l];
+        const double exp_prefactor = h_exp_prefactor[l];
+        const double ln_prefactor = std::log(static_cast<double>(h_prefactor[l]));
+        auto ln_rate = [=] (double ln_E) {
+            return ln_prefactor + power*ln_E + exp_prefactor*std::exp(-ln_E);
+        };
+        const double ln_E_peak = std::log(exp_prefactor/power);
+        double ln_E_min = ln_E_peak;
+        if (ln_rate(ln_E_peak) > std::log(w_min)) {
+            // ln_rate is monotonic below E_peak: bisect
+            double lo = ln_E_peak - 50., hi = ln_E_peak;
+            for (int it = 0; it < 100; ++it) {
+                const double mid = 0.5*(lo + hi);
+                if (ln_rate(mid) < std::log(w_min)) lo = mid;
+                else hi = mid;
+            }
+            ln_E_min = lo;
+        }
+        h_E_min[l] = static_cast<Real>(std::exp(ln_E_min));
+        h_E_max[l] = static_cast<Real>(std::exp(ln_E_peak));
+        h_ln_E_min[l] = static_cast<Real>(ln_E_min);
+        const double dln_E = (ntab > 1) ? (ln_E_peak - ln_E_min)/(ntab - 1) : 0.;
+        h_inv_dln_E[l] = (dln_E > 0.) ? static_cast<Real>(1./dln_E) : 0._rt;
+        for (int i = 0; i < ntab; ++i) {
+            h_ln_rate[l*ntab + i] = static_cast<Real>(ln_rate(ln_E_min + i*dln_E));
+        }
+    }
+
+    auto to_device = [] (Vector<Real> const& h, Gpu::DeviceVector<Real>& d) {
+        d.resize(h.size());
+        Gpu::copyAsync(Gpu::hostToDevice, h.begin(), h.end(), d.begin());
+    };
+    to_device(h_E_min, adk_table_E_min);
+    to_device(h_E_max, adk_table_E_max);
+    to_device(h_ln_E_min, adk_table_ln_E_min);
+    to_device(h_inv_dln_E, adk_table_inv_dln_E);
+    to_device(h_ln_rate, adk_table_ln_rate);
+    Gpu::streamSynchronize();
 }
 
 IonizationFilterFunc
@@ -3464,13 +3680,93 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
 {
     WARPX_PROFILE("PhysicalParticleContainer::getIonizationFunc()");
 
+    amrex::ParticleReal* cached_fields = nullptr;
+    if (useGatheredFieldsCache()) {
+        cached_fields = fillGatheredFieldsCache(lev, pti);
+    }
+
     return IonizationFilterFunc(pti, lev, ngEB, Ex, Ey, Ez, Bx, By, Bz,
                                 ionization_energies.dataPtr(),
                                 adk_prefactor.dataPtr(),
                                 adk_exp_prefactor.dataPtr(),
                                 adk_power.dataPtr(),
                                 particle_icomps["ionizationLevel"],
-                                ion_atomic_number);
+                                ion_atomic_number, 0, cached_fields,
+                                getADKRateTable());
+}
+
+ADKRateTable
+PhysicalParticleContainer::getADKRateTable () const
+{
+    ADKRateTable table;
+    if (adk_table_E_min.empty()) return table;
+    table.size = ionization_table_size;
+    table.E_min = adk_table_E_min.dataPtr();
+    table.E_max = adk_table_E_max.dataPtr();
+    table.ln_E_min = adk_table_ln_E_min.dataPtr();
+    table.inv_dln_E = adk_table_inv_dln_E.dataPtr();
+    table.ln_rate = adk_table_ln_rate.dataPtr();
+    return table;
+}
+
+bool
+PhysicalParticleContainer::useGatheredFieldsCache () const
+{
+    // The ionization filter and the push gather the same (aux) fields at the
+    // same positions only if the push does not filter the fields, does not
+    // gather from a different set of fields, and happens within the same step.
+    return m_cache_gathered_fields && do_field_ionization &&
+        !do_not_gather && !do_not_push &&
+        !WarpX::use_fdtd_nci_corr && !WarpX::do_subcycling;
+}
+
+amrex::ParticleReal*
+PhysicalParticleContainer::fillGatheredFieldsCache (int lev, const WarpXParIter& pti)
+{
+    GatheredFieldsCacheEntry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_gathered_fields)
+#endif
+    {
+        if (static_cast<int>(m_gathered_fields.size()) <= lev) m_gathered_fields.resize(finestLevel()+1);
+        entry = &m_gathered_fields[lev][pti.GetPairIndex()];
+    }
+
+    const long np = pti.numParticles();
+    entry->fields.resize(6*np);
+    entry->step = WarpX::GetInstance().getistep(lev);
+    entry->np = np;
+    entry->box = pti.tilebox();
+    return entry->fields.dataPtr();
+}
+
+long
+PhysicalParticleContainer::findGatheredFieldsCache (int lev, const WarpXParIter& pti,
+                                                    amrex::ParticleReal const*& data,
+                                                    long& stride) const
+{
+    data = nullptr;
+    stride = 0;
+    if (static_cast<int>(m_gathered_fields.size()) <= lev) return 0;
+
+    auto const& cache = m_gathered_fields[lev];
+    auto const it = cache.find(pti.GetPairIndex());
+    if (it == cache.end()) return 0;
+
+    auto const& entry = it->second;
+    if (entry.step != WarpX::GetInstance().getistep(lev) || entry.box != pti.tilebox()) return 0;
+
+    data = entry.fields.dataPtr();
+    stride = entry.np;
+    // Particles appended to the tile since the cache was filled (e.g. by
+    // collisions or QED processes) are gathered by the caller
+    return std::min(entry.np, static_cast<long>(pti.numParticles()));
+}
+
+void
+PhysicalParticleContainer::clearGatheredFieldsCache (int lev) noexcept
+{
+    if (lev < static_cast<int>(m_gathered_fields.size())) m_gathered_fields[lev].clear();
 }
 
 void PhysicalParticleContainer::resample (const int timestep)
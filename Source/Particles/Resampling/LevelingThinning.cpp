@@ -7,7 +7,6 @@
 #include "LevelingThinning.H"
 
 #include "Particles/WarpXParticleContainer.H"
-#include "Utils/ParticleUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXUtil.H"
 
@@ -66,7 +65,7 @@ void LevelingThinning::operator() (WarpXParIter& pti, const int lev,
     // efficient to directly loop over the particles. Nevertheless, this structure with a loop over
     // the cells is more general and can be readily used to implement almost any other resampling
     // algorithm.
-    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+    auto& bins = pc->getCellBins(lev, pti);
 
     const int n_cells = bins.numBins();
     const auto indices = bins.permutationPtr();
@@ -16,6 +16,7 @@
 #include "Pusher/UpdatePosition.H"
 #include "ParticleBoundaries_K.H"
 #include "Utils/CoarsenMR.H"
+#include "Utils/ParticleUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
@@ -941,6 +942,8 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
     if (do_not_push) return;
 
+    invalidateCellBins();
+
     amrex::LayoutData<amrex::Real>* costs = WarpX::getCosts(lev);
 
 #ifdef AMREX_USE_OMP
@@ -989,6 +992,38 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
     }
 }
 
+WarpXParticleContainer::CellBins&
+WarpXParticleContainer::getCellBins (int lev, amrex::MFIter const& mfi)
+{
+    auto& ptile = ParticlesAt(lev, mfi);
+    const int step = WarpX::GetInstance().getistep(lev);
+    const long np = ptile.numParticles();
+    const Box box = mfi.tilebox(IntVect::TheZeroVector());
+
+    CellBinsCacheEntry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (warpx_cell_bins)
+#endif
+    {
+        if (static_cast<int>(m_cell_bins.size()) <= lev) m_cell_bins.resize(finestLevel()+1);
+        entry = &m_cell_bins[lev][std::make_pair(mfi.index(), mfi.LocalTileIndex())];
+    }
+
+    if (entry->step != step || entry->np != np || entry->box != box) {
+        entry->bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        entry->step = step;
+        entry->np = np;
+        entry->box = box;
+    }
+    return entry->bins;
+}
+
+void
+WarpXParticleContainer::invalidateCellBins () noexcept
+{
+    m_cell_bins.clear();
+}
+
 // When using runtime components, AMReX requires to touch all tiles
 // in serial and create particles tiles with runtime components if
 // they do not exist (or if they were defined by default, i.e.,
@@ -37,6 +37,7 @@
 
 #include <array>
 #include <cstdlib>
+#include <string>
 
 namespace
 {
@@ -101,6 +102,16 @@ namespace
         }
         return nodal_flag_data;
     }
+    // Particle container of a species accessed from Python: the particles of
+    // a species whose restart was deferred (<species>.restart_deferred = 1)
+    // are read first. This is collective, like the deferred restart itself.
+    WarpXParticleContainer& getSpeciesParticles (const char* char_species_name)
+    {
+        auto & mypc = WarpX::GetInstance().GetPartContainer();
+        const std::string species_name(char_species_name);
+        mypc.LoadDeferredSpecies({species_name});
+        return mypc.GetParticleContainerFromName(species_name);
+    }
 }
 
     int warpx_Real_size()
@@ -202,9 +213,7 @@ namespace
         amrex::ParticleReal const * attr_real, const int nattr_int,
         int const * attr_int, int uniqueparticles)
     {
-        auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
         const int lev = 0;
         myspc.AddNParticles(lev, lenx, x, y, z, vx, vy, vz, nattr_real, attr_real,
                             nattr_int, attr_int, uniqueparticles);
@@ -245,9 +254,7 @@ namespace
     }
 
     long warpx_getNumParticles(const char* char_species_name, const bool local) {
-        const auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
         // the first argument below is to only count valid particles
         return myspc.TotalNumberOfParticles(true, local);
     }
@@ -446,9 +453,7 @@ namespace
     amrex::ParticleReal** warpx_getParticleStructs(
             const char* char_species_name, int lev,
             int* num_tiles, int** particles_per_tile) {
-        const auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
 
         *num_tiles = myspc.numLocalTilesAtLevel(lev);
         *particles_per_tile = static_cast<int*>(malloc(*num_tiles*sizeof(int)));
@@ -468,9 +473,7 @@ namespace
             const char* char_species_name, const char* char_comp_name,
             int lev, int* num_tiles, int** particles_per_tile ) {
 
-        const auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
 
         int comp = warpx_getParticleCompIndex(char_species_name, char_comp_name);
 
@@ -506,8 +509,7 @@ namespace
         const char* char_comp_name, bool comm=true)
     {
         auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
 
         const std::string comp_name(char_comp_name);
         myspc.AddRealComp(comp_name, comm);
@@ -517,9 +519,7 @@ namespace
 
     amrex::Real warpx_sumParticleCharge(const char* char_species_name, const bool local)
     {
-        auto & mypc = WarpX::GetInstance().GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
         return myspc.sumParticleCharge(local);
     }
 
@@ -609,9 +609,7 @@ namespace
         // in the rho_fp multifab which can then be accessed from python via
         // pywarpx.fields.RhoFPWrapper()
         WarpX& warpx = WarpX::GetInstance();
-        const auto & mypc = warpx.GetPartContainer();
-        const std::string species_name(char_species_name);
-        auto & myspc = mypc.GetParticleContainerFromName(species_name);
+        auto & myspc = getSpeciesParticles(char_species_name);
         auto * rho_fp = warpx.get_pointer_rho_fp(lev);
 
         if (rho_fp == nullptr) {
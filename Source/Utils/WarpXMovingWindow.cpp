@@ -45,6 +45,7 @@
 
 #include <AMReX_BaseFwd.H>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <memory>
@@ -251,7 +252,13 @@ WarpX::MoveWindow (const int step, bool move_j)
                 }
             }
         }
+
+        // The previous solutions of the lab-frame Poisson equation, used to extrapolate
+        // the guess of the next solve, are not shifted: they are discarded
+        m_phi_history[lev].clear();
     }
+    // the next guess is the last solution (phi_fp), which is then saved again for the extrapolation
+    m_num_phi_solutions = std::min(m_num_phi_solutions, 1);
 
     // Continuously inject plasma in new cells (by default only on level 0)
     if (WarpX::warpx_do_continuous_injection) {
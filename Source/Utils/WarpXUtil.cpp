@@ -25,6 +25,7 @@
 #include <AMReX_GpuLaunch.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Parser.H>
 
@@ -32,8 +33,12 @@
 #include <array>
 #include <cmath>
 #include <cstring>
+#include <cstdint>
 #include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <set>
+#include <sstream>
 #include <string>
 #include <limits>
 
@@ -262,6 +267,113 @@ namespace WarpXUtilIO{
         of.close();
         return  of.good();
     }
+
+    NodeSharedFileData::NodeSharedFileData (std::string const& filename)
+    {
+        auto read_file = [&filename] (amrex::Vector<char>& buffer) {
+            std::ifstream ifs{filename, std::ios::binary | std::ios::ate};
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ifs.good(), "Unable to open file " + filename);
+            buffer.resize(static_cast<std::size_t>(ifs.tellg()));
+            ifs.seekg(0);
+            ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ifs.good(), "Unable to read file " + filename);
+        };
+
+#ifdef AMREX_USE_MPI
+        MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+        int const rank = amrex::ParallelDescriptor::MyProc();
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &m_node_comm);
+        int node_rank = 0;
+        MPI_Comm_rank(m_node_comm, &node_rank);
+        // Rank 0 is the first rank of its node: it reads the file
+        MPI_Comm leader_comm = MPI_COMM_NULL;
+        MPI_Comm_split(comm, (node_rank == 0) ? 0 : MPI_UNDEFINED, rank, &leader_comm);
+
+        amrex::Vector<char> file_data;
+        unsigned long long size = 0;
+        if (rank == 0) {
+            read_file(file_data);
+            size = file_data.size();
+        }
+        MPI_Bcast(&size, 1, MPI_UNSIGNED_LONG_LONG, 0, comm);
+        m_size = static_cast<std::size_t>(size);
+
+        char* base = nullptr;
+        MPI_Win_allocate_shared((node_rank == 0) ? static_cast<MPI_Aint>(m_size) : 0, 1,
+                                MPI_INFO_NULL, m_node_comm, &base, &m_win);
+        if (node_rank == 0) {
+            if (rank == 0) std::copy(file_data.begin(), file_data.end(), base);
+            // MPI counts are ints: broadcast by chunks
+            constexpr std::size_t chunk = std::numeric_limits<int>::max();
+            for (std::size_t offset = 0; offset < m_size; offset += chunk) {
+                const int count = static_cast<int>(std::min(chunk, m_size - offset));
+                MPI_Bcast(base + offset, count, MPI_CHAR, 0, leader_comm);
+            }
+            MPI_Comm_free(&leader_comm);
+        } else {
+            MPI_Aint win_size = 0;
+            int disp_unit = 0;
+            MPI_Win_shared_query(m_win, 0, &win_size, &disp_unit, &base);
+        }
+        // Make the data written by the first rank of the node visible to the others
+        MPI_Win_fence(0, m_win);
+        m_data = base;
+#else
+        read_file(m_local_data);
+        m_data = m_local_data.data();
+        m_size = m_local_data.size();
+#endif
+    }
+
+    NodeSharedFileData::~NodeSharedFileData ()
+    {
+#ifdef AMREX_USE_MPI
+        if (m_win != MPI_WIN_NULL) MPI_Win_free(&m_win);
+        if (m_node_comm != MPI_COMM_NULL) MPI_Comm_free(&m_node_comm);
+#endif
+    }
+
+    std::string CachedFileName (std::string const& dir, std::string const& prefix,
+                                std::string const& key)
+    {
+        // 64-bit FNV-1a hash: stable across compilers and runs
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const char c : key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        std::ostringstream name;
+        name << dir << "/" << prefix << "_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return name.str();
+    }
+
+    bool IsCachedFileValid (std::string const& filename, std::string const& key)
+    {
+        int valid = 0;
+        if (amrex::ParallelDescriptor::IOProcessor()) {
+            std::ifstream key_file{filename + ".key", std::ios::binary};
+            const std::string stored_key{std::istreambuf_iterator<char>(key_file),
+                                         std::istreambuf_iterator<char>()};
+            valid = (key_file.good() || key_file.eof()) && stored_key == key &&
+                std::ifstream{filename, std::ios::binary}.good();
+        }
+        amrex::ParallelDescriptor::Bcast(&valid, 1, amrex::ParallelDescriptor::IOProcessorNumber());
+        return valid != 0;
+    }
+
+    bool WriteCachedFile (std::string const& filename, std::string const& key,
+                          const amrex::Vector<char>& data)
+    {
+        const auto slash = filename.rfind('/');
+        if (slash != std::string::npos && slash > 0) {
+            amrex::UtilCreateDirectory(filename.substr(0, slash), 0755);
+        }
+        if (!WriteBinaryDataOnFile(filename, data)) return false;
+        std::ofstream key_file{filename + ".key", std::ios::binary};
+        key_file << key;
+        key_file.close();
+        return key_file.good();
+    }
 }
 
 void Store_parserString(const amrex::ParmParse& pp, std::string query_string,
@@ -25,6 +25,7 @@
 #       include "BoundaryConditions/PML_RZ.H"
 #   else
 #       include "FieldSolver/SpectralSolver/SpectralSolver.H"
+#       include "FieldSolver/SpectralSolver/SpectralPoissonSolver.H"
 #   endif // RZ ifdef
 #endif // use PSATD ifdef
 #include "FieldSolver/WarpX_FDTD.H"
@@ -181,10 +182,15 @@ Real WarpX::particle_slice_width_lab = 0.0_rt;
 bool WarpX::do_dynamic_scheduling = true;
 
 int WarpX::do_electrostatic;
+int WarpX::poisson_solver_id = PoissonSolverAlgo::Multigrid;
 Real WarpX::self_fields_required_precision = 1.e-11_rt;
 Real WarpX::self_fields_absolute_tolerance = 0.0_rt;
 int WarpX::self_fields_max_iters = 200;
 int WarpX::self_fields_verbosity = 0;
+bool WarpX::self_fields_reuse_solver = false;
+int WarpX::self_fields_guess_order = 0;
+bool WarpX::self_fields_group_species = false;
+Real WarpX::self_fields_group_beta_tolerance = 0.0_rt;
 int WarpX::screenout_interval = 100;
 
 bool WarpX::do_subcycling = false;
@@ -201,6 +207,7 @@ bool WarpX::do_nodal = false;
 amrex::IntVect m_rho_nodal_flag;
 
 int WarpX::do_similar_dm_pml = 1;
+int WarpX::do_pml_load_balance = 0;
 
 #ifdef AMREX_USE_GPU
 bool WarpX::do_device_synchronize = true;
@@ -287,6 +294,7 @@ WarpX::WarpX ()
     G_fp.resize(nlevs_max);
     rho_fp.resize(nlevs_max);
     phi_fp.resize(nlevs_max);
+    m_phi_history.resize(nlevs_max);
     current_fp.resize(nlevs_max);
     Efield_fp.resize(nlevs_max);
     Bfield_fp.resize(nlevs_max);
@@ -404,6 +412,9 @@ WarpX::WarpX ()
         costs_heuristic_particles_wt = 0.9_rt;
 #endif // AMREX_USE_GPU
     }
+    if (costs_heuristic_pml_cells_wt < 0.) {
+        costs_heuristic_pml_cells_wt = 2._rt*costs_heuristic_cells_wt;
+    }
 
     // Allocate field solver objects
 #ifdef WARPX_USE_PSATD
@@ -684,6 +695,19 @@ WarpX::ReadParameters ()
         "Currently, the embedded boundary in RZ only works for electrostatic solvers.");
 #endif
 
+        if (do_electrostatic != ElectrostaticSolverAlgo::None) {
+            poisson_solver_id = GetAlgorithmInteger(pp_warpx, "poisson_solver");
+        }
+        if (poisson_solver_id == PoissonSolverAlgo::FFT) {
+#if !defined(WARPX_USE_PSATD) || defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z) || defined(AMREX_USE_EB)
+            amrex::Abort(Utils::TextMsg::Err(
+                "warpx.poisson_solver = fft requires WarpX to be compiled with PSATD support, "
+                "in Cartesian 2D or 3D geometry and without embedded boundaries"));
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(maxLevel() == 0,
+                "warpx.poisson_solver = fft does not support mesh refinement");
+        }
+
         if (do_electrostatic == ElectrostaticSolverAlgo::LabFrame) {
             // Note that with the relativistic version, these parameters would be
             // input for each species.
@@ -691,7 +715,14 @@ WarpX::ReadParameters ()
             queryWithParser(pp_warpx, "self_fields_absolute_tolerance", self_fields_absolute_tolerance);
             queryWithParser(pp_warpx, "self_fields_max_iters", self_fields_max_iters);
             pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
+            pp_warpx.query("self_fields_guess_order", self_fields_guess_order);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                self_fields_guess_order >= 0 && self_fields_guess_order <= 2,
+                "warpx.self_fields_guess_order must be 0, 1 or 2");
         }
+        pp_warpx.query("self_fields_reuse_solver", self_fields_reuse_solver);
+        pp_warpx.query("self_fields_group_species", self_fields_group_species);
+        queryWithParser(pp_warpx, "self_fields_group_beta_tolerance", self_fields_group_beta_tolerance);
         // Parse the input file for domain boundary potentials
         ParmParse pp_boundary("boundary");
         pp_boundary.query("potential_lo_x", m_poisson_boundary_handler.potential_xlo_str);
@@ -804,6 +835,10 @@ WarpX::ReadParameters ()
         pp_warpx.query("do_pml_j_damping", do_pml_j_damping);
         pp_warpx.query("do_pml_in_domain", do_pml_in_domain);
         pp_warpx.query("do_similar_dm_pml", do_similar_dm_pml);
+        pp_warpx.query("do_pml_load_balance", do_pml_load_balance);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !do_pml_load_balance || maxwell_solver_id != MaxwellSolverAlgo::PSATD,
+            "warpx.do_pml_load_balance = 1 is only implemented for FDTD solvers");
         // Read `v_particle_pml` in units of the speed of light
         v_particle_pml = 1._rt;
         queryWithParser(pp_warpx, "v_particle_pml", v_particle_pml);
@@ -861,6 +896,18 @@ WarpX::ReadParameters ()
             );
         }
 
+        // Fuse the PML damping with the FDTD update of the split fields
+        pp_warpx.query("pml_fused_damping", pml_fused_damping);
+        if (pml_fused_damping)
+        {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxwell_solver_id != MaxwellSolverAlgo::PSATD,
+                "warpx.pml_fused_damping = 1 is only implemented for FDTD solvers");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                do_subcycling == false,
+                "warpx.pml_fused_damping = 1 is not implemented with subcycling");
+        }
+
 #ifdef WARPX_DIM_RZ
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE( isAnyBoundaryPML() == false || maxwell_solver_id == MaxwellSolverAlgo::PSATD,
             "PML are not implemented in RZ geometry with FDTD; please set a different boundary condition using boundary.field_lo and boundary.field_hi.");
@@ -1001,11 +1048,16 @@ WarpX::ReadParameters ()
         load_balance_intervals = IntervalsParser(load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
         pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp_algo.query("load_balance_on_restart", load_balance_on_restart);
         queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         load_balance_costs_update_algo = GetAlgorithmInteger(pp_algo, "load_balance_costs_update");
         queryWithParser(pp_algo, "costs_heuristic_cells_wt", costs_heuristic_cells_wt);
         queryWithParser(pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
+        if (queryWithParser(pp_algo, "costs_heuristic_pml_cells_wt", costs_heuristic_pml_cells_wt)) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(costs_heuristic_pml_cells_wt >= 0.,
+                "algo.costs_heuristic_pml_cells_wt must be non-negative");
+        }
 
         // Parse algo.particle_shape and check that input is acceptable
         // (do this only if there is at least one particle or laser species)
@@ -1564,6 +1616,8 @@ WarpX::MakeNewLevelFromCoarse (int /*lev*/, amrex::Real /*time*/, const amrex::B
 void
 WarpX::ClearLevel (int lev)
 {
+    if (m_poisson_solver_cache) m_poisson_solver_cache->clear();
+
     for (int i = 0; i < 3; ++i) {
         Efield_aux[lev][i].reset();
         Bfield_aux[lev][i].reset();
@@ -1602,6 +1656,7 @@ WarpX::ClearLevel (int lev)
     G_fp  [lev].reset();
     rho_fp[lev].reset();
     phi_fp[lev].reset();
+    m_phi_history[lev].clear();
     F_cp  [lev].reset();
     G_cp  [lev].reset();
     rho_cp[lev].reset();